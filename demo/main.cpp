@@ -24,8 +24,8 @@ typedef enum {
 using namespace paramkit;
 
 typedef struct {
-    DWORD myDec;
-    DWORD myHex;
+    uint32_t myDec;
+    uint32_t myHex;
     bool myBool;
     char myABuf[MAX_BUF];
     wchar_t myWBuf[MAX_BUF];
@@ -88,8 +88,8 @@ public:
         copyVal<IntParam>(PARAM_MY_HEX, paramsStruct.myHex);
         copyVal<EnumParam>(PARAM_MY_ENUM, paramsStruct.myEnum);
 
-        copyCStr<StringParam>(PARAM_MY_ASTRING, paramsStruct.myABuf, _countof(paramsStruct.myABuf));
-        copyCStr<WStringParam>(PARAM_MY_WSTRING, paramsStruct.myWBuf, _countof(paramsStruct.myWBuf));
+        copyCStr<StringParam>(PARAM_MY_ASTRING, paramsStruct.myABuf, MAX_BUF);
+        copyCStr<WStringParam>(PARAM_MY_WSTRING, paramsStruct.myWBuf, MAX_BUF);
         return true;
     }
 
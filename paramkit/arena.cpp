@@ -0,0 +1,71 @@
+#include "arena.h"
+
+#include <stdint.h>
+
+char* paramkit::util::MonotonicArena::fitCurrent(size_t size, size_t alignment) const
+{
+    if (!current) return nullptr;
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(current);
+    const uintptr_t aligned = (address + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(currentEnd);
+    if (aligned > end || (end - aligned) < size) {
+        return nullptr;
+    }
+    return reinterpret_cast<char*>(aligned);
+}
+
+void* paramkit::util::MonotonicArena::allocate(size_t size, size_t alignment)
+{
+    if (!alignment) alignment = 1;
+
+    char *ptr = fitCurrent(size, alignment);
+    if (!ptr) {
+        // start a new block: big enough for the requested size, including the alignment
+        const size_t needed = size + alignment;
+        Block block;
+        block.size = (needed > blockSize) ? needed : blockSize;
+        block.start = static_cast<char*>(::operator new(block.size));
+        blocks.push_back(block);
+        allocatedTotal += block.size;
+
+        current = block.start;
+        currentEnd = block.start + block.size;
+        ptr = fitCurrent(size, alignment);
+    }
+    current = ptr + size;
+    return ptr;
+}
+
+bool paramkit::util::MonotonicArena::owns(const void *ptr) const
+{
+    const char *p = static_cast<const char*>(ptr);
+    if (initialBuf && p >= initialBuf && p < initialBuf + initialBufSize) {
+        return true;
+    }
+    std::vector<Block>::const_iterator itr;
+    for (itr = blocks.begin(); itr != blocks.end(); ++itr) {
+        if (p >= itr->start && p < itr->start + itr->size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void paramkit::util::MonotonicArena::release()
+{
+    // destroy in the reverse order of the creation:
+    std::vector<std::pair<void*, t_destructor> >::reverse_iterator objItr;
+    for (objItr = objects.rbegin(); objItr != objects.rend(); ++objItr) {
+        objItr->second(objItr->first);
+    }
+    objects.clear();
+
+    std::vector<Block>::iterator itr;
+    for (itr = blocks.begin(); itr != blocks.end(); ++itr) {
+        ::operator delete(itr->start);
+    }
+    blocks.clear();
+    allocatedTotal = 0;
+    resetCurrent();
+}
@@ -0,0 +1,471 @@
+#include "config_file.h"
+
+#include <cstring>
+
+namespace paramkit {
+    namespace util {
+
+        inline bool is_blank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        //! Characters allowed in the unquoted JSON values: numbers, and the literals
+        inline bool is_json_literal_char(char c)
+        {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-' || c == '+' || c == '.' || c == '_';
+        }
+
+    }; //namespace util
+}; //namespace paramkit
+
+namespace {
+
+    //! Appends the code point, encoded in UTF-8
+    void append_code_point(std::string &out, unsigned long code)
+    {
+        if (code < 0x80) {
+            out.push_back((char)code);
+        }
+        else if (code < 0x800) {
+            out.push_back((char)(0xC0 | (code >> 6)));
+            out.push_back((char)(0x80 | (code & 0x3F)));
+        }
+        else if (code < 0x10000) {
+            out.push_back((char)(0xE0 | (code >> 12)));
+            out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (code & 0x3F)));
+        }
+        else {
+            out.push_back((char)(0xF0 | (code >> 18)));
+            out.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (code & 0x3F)));
+        }
+    }
+
+    bool is_high_surrogate(unsigned long code)
+    {
+        return code >= 0xD800 && code <= 0xDBFF;
+    }
+
+    bool is_low_surrogate(unsigned long code)
+    {
+        return code >= 0xDC00 && code <= 0xDFFF;
+    }
+
+}; // anonymous namespace
+
+bool paramkit::util::ConfigReader::read(ConfigHandler &handler, std::vector<ConfigError> &errors)
+{
+    pos = 0;
+    line = 1;
+    lineStart = 0;
+    skipBom();
+
+    t_config_format fileFormat = format;
+    if (fileFormat == CONFIG_AUTO) {
+        skipSpaces(false);
+        fileFormat = (!isEnd() && buf[pos] == '{') ? CONFIG_JSON : CONFIG_INI;
+    }
+    if (fileFormat == CONFIG_JSON) {
+        return readJson(handler, errors);
+    }
+    return readIni(handler, errors);
+}
+
+void paramkit::util::ConfigReader::skipBom()
+{
+    const char bom[] = "\xEF\xBB\xBF";
+    const size_t bomLen = sizeof(bom) - 1;
+    if (len >= bomLen && memcmp(buf, bom, bomLen) == 0) {
+        pos = bomLen;
+        lineStart = bomLen;
+    }
+}
+
+void paramkit::util::ConfigReader::skipSpaces(bool stopAtNewLine)
+{
+    while (!isEnd()) {
+        const char c = buf[pos];
+        if (c == '\n') {
+            if (stopAtNewLine) return;
+            pos++;
+            newLine();
+            continue;
+        }
+        if (!is_blank(c)) return;
+        pos++;
+    }
+}
+
+void paramkit::util::ConfigReader::skipLine()
+{
+    const void *found = memchr(buf + pos, '\n', len - pos);
+    if (!found) {
+        pos = len;
+        return;
+    }
+    pos = (static_cast<const char*>(found) - buf) + 1;
+    newLine();
+}
+
+bool paramkit::util::ConfigReader::dispatch(ConfigHandler &handler, const StringView &key, const char *value, size_t keyLine, size_t keyColumn, std::vector<ConfigError> &errors)
+{
+    std::string errorMsg;
+    if (handler.onEntry(key, value, errorMsg)) {
+        return true;
+    }
+    errors.push_back(ConfigError(keyLine, keyColumn, errorMsg.length() ? errorMsg : ("Invalid entry: " + key.str())));
+    return false;
+}
+
+bool paramkit::util::ConfigReader::readIniValue(std::string &errorMsg)
+{
+    valueBuf.clear();
+    skipSpaces(true);
+    if (isEnd() || buf[pos] != '"') {
+        // unquoted: till the end of the line, or till the comment that is preceded by a whitespace, with the trailing whitespaces trimmed
+        const size_t start = pos;
+        const void *found = memchr(buf + pos, '\n', len - pos);
+        const size_t lineEnd = found ? (size_t)(static_cast<const char*>(found) - buf) : len;
+        size_t end = start;
+        for (; end < lineEnd; end++) {
+            const char c = buf[end];
+            if ((c == ';' || c == '#') && (end == start || is_blank(buf[end - 1]))) break;
+        }
+        pos = lineEnd;
+        while (end > start && is_blank(buf[end - 1])) end--;
+        valueBuf.assign(buf + start, end - start);
+        return true;
+    }
+    // quoted: the escapes \" \\ \n \t are recognized
+    pos++;
+    while (!isEnd() && buf[pos] != '"' && buf[pos] != '\n') {
+        char c = buf[pos++];
+        if (c == '\\' && !isEnd()) {
+            const char escaped = buf[pos++];
+            switch (escaped) {
+            case 'n': c = '\n'; break;
+            case 't': c = '\t'; break;
+            case '"': case '\\': c = escaped; break;
+            default:
+                errorMsg = std::string("Unknown escape sequence: \\") + escaped;
+                return false;
+            }
+        }
+        valueBuf.push_back(c);
+    }
+    if (isEnd() || buf[pos] != '"') {
+        errorMsg = "Missing the closing quote";
+        return false;
+    }
+    pos++;
+    // only a comment may follow the quoted value:
+    skipSpaces(true);
+    if (!isEnd() && buf[pos] != '\n' && buf[pos] != ';' && buf[pos] != '#') {
+        errorMsg = "Unexpected characters after the quoted value";
+        return false;
+    }
+    return true;
+}
+
+bool paramkit::util::ConfigReader::readIni(ConfigHandler &handler, std::vector<ConfigError> &errors)
+{
+    bool isOk = true;
+    while (!isEnd()) {
+        skipSpaces(true);
+        if (isEnd()) break;
+
+        const char c = buf[pos];
+        if (c == '\n' || c == ';' || c == '#') {
+            skipLine();
+            continue;
+        }
+        if (c == '[') {
+            // the section: only validated
+            const void *found = memchr(buf + pos, '\n', len - pos);
+            const size_t lineEnd = found ? (size_t)(static_cast<const char*>(found) - buf) : len;
+            const void *closing = memchr(buf + pos, ']', lineEnd - pos);
+            if (!closing) {
+                errors.push_back(ConfigError(line, column(), "Missing the closing bracket of the section"));
+                isOk = false;
+            }
+            skipLine();
+            continue;
+        }
+        const size_t keyLine = line;
+        const size_t keyColumn = column();
+        const size_t keyStart = pos;
+        while (!isEnd() && buf[pos] != '=' && buf[pos] != '\n') pos++;
+
+        size_t keyEnd = pos;
+        while (keyEnd > keyStart && is_blank(buf[keyEnd - 1])) keyEnd--;
+        const StringView key(buf + keyStart, keyEnd - keyStart);
+        if (!key.length()) {
+            errors.push_back(ConfigError(keyLine, keyColumn, "Missing the key"));
+            isOk = false;
+            skipLine();
+            continue;
+        }
+        if (isEnd() || buf[pos] == '\n') {
+            // the key without a value
+            if (!dispatch(handler, key, nullptr, keyLine, keyColumn, errors)) {
+                isOk = false;
+            }
+            skipLine();
+            continue;
+        }
+        pos++; // skip the '='
+        const size_t valueColumn = column();
+        std::string errorMsg;
+        if (!readIniValue(errorMsg)) {
+            errors.push_back(ConfigError(line, column(), errorMsg));
+            isOk = false;
+        }
+        else if (!dispatch(handler, key, valueBuf.c_str(), keyLine, valueColumn, errors)) {
+            isOk = false;
+        }
+        skipLine();
+    }
+    return isOk;
+}
+
+bool paramkit::util::ConfigReader::readJsonString(std::string *out, std::string &errorMsg)
+{
+    pos++; // skip the opening quote
+    while (!isEnd() && buf[pos] != '"') {
+        char c = buf[pos];
+        if (c == '\n' || (unsigned char)c < 0x20) {
+            errorMsg = "Control character in the string";
+            return false;
+        }
+        pos++;
+        if (c != '\\') {
+            if (out) out->push_back(c);
+            continue;
+        }
+        if (isEnd()) break;
+        const char escaped = buf[pos++];
+        switch (escaped) {
+        case '"': case '\\': case '/': c = escaped; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u':
+        {
+            unsigned long code = 0;
+            if (!readJsonHex4(code, errorMsg)) {
+                return false;
+            }
+            // the characters out of the BMP are given as the surrogate pairs:
+            if (is_high_surrogate(code)) {
+                unsigned long low = 0;
+                if (len - pos < 2 || buf[pos] != '\\' || buf[pos + 1] != 'u') {
+                    errorMsg = "Unpaired surrogate in the \\u escape sequence";
+                    return false;
+                }
+                pos += 2;
+                if (!readJsonHex4(low, errorMsg)) {
+                    return false;
+                }
+                if (!is_low_surrogate(low)) {
+                    errorMsg = "Unpaired surrogate in the \\u escape sequence";
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            else if (is_low_surrogate(code)) {
+                errorMsg = "Unpaired surrogate in the \\u escape sequence";
+                return false;
+            }
+            // the values are passed as the NUL-terminated strings:
+            if (code == 0) {
+                errorMsg = "The NUL character is not allowed";
+                return false;
+            }
+            if (out) append_code_point(*out, code);
+            continue;
+        }
+        default:
+            pos--;
+            errorMsg = std::string("Unknown escape sequence: \\") + escaped;
+            return false;
+        }
+        if (out) out->push_back(c);
+    }
+    if (isEnd()) {
+        errorMsg = "Missing the closing quote";
+        return false;
+    }
+    pos++; // skip the closing quote
+    return true;
+}
+
+bool paramkit::util::ConfigReader::readJsonHex4(unsigned long &code, std::string &errorMsg)
+{
+    code = 0;
+    for (size_t i = 0; i < 4; i++, pos++) {
+        const char h = isEnd() ? 0 : buf[pos];
+        code <<= 4;
+        if (h >= '0' && h <= '9') code |= (h - '0');
+        else if (h >= 'a' && h <= 'f') code |= (h - 'a' + 10);
+        else if (h >= 'A' && h <= 'F') code |= (h - 'A' + 10);
+        else {
+            errorMsg = "Invalid \\u escape sequence";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool paramkit::util::ConfigReader::readJsonScalar(bool &isNull, std::string &errorMsg)
+{
+    isNull = false;
+    if (isEnd()) {
+        errorMsg = "Missing the value";
+        return false;
+    }
+    if (buf[pos] == '"') {
+        return readJsonString(&valueBuf, errorMsg);
+    }
+    const size_t start = pos;
+    while (!isEnd() && is_json_literal_char(buf[pos])) pos++;
+    const StringView literal(buf + start, pos - start);
+    if (!literal.length()) {
+        errorMsg = (buf[pos] == '{') ? "Nested objects are not supported" : "Invalid value";
+        return false;
+    }
+    if (literal == "null") {
+        isNull = true;
+        return true;
+    }
+    // the numbers and true/false are passed as they are:
+    valueBuf.append(literal.data(), literal.length());
+    return true;
+}
+
+bool paramkit::util::ConfigReader::readJsonValue(ConfigHandler &handler, const StringView &key, bool &isNull, std::string &errorMsg)
+{
+    valueBuf.clear();
+    isNull = false;
+    if (isEnd() || buf[pos] != '[') {
+        return readJsonScalar(isNull, errorMsg);
+    }
+    // the array of the scalars: joined into a list, with the delimiter of the target
+    pos++;
+    skipSpaces(false);
+    if (!isEnd() && buf[pos] == ']') {
+        pos++;
+        return true;
+    }
+    const std::string delimiter = handler.listDelimiter(key);
+    while (true) {
+        skipSpaces(false);
+        if (!isEnd() && buf[pos] == '[') {
+            errorMsg = "Nested arrays are not supported";
+            return false;
+        }
+        const size_t elementStart = valueBuf.length();
+        bool isElementNull = false;
+        if (!readJsonScalar(isElementNull, errorMsg)) {
+            return false;
+        }
+        // the element containing the delimiter would be split into multiple ones:
+        if (delimiter.length() && valueBuf.find(delimiter, elementStart) != std::string::npos) {
+            errorMsg = "The element of the array contains the delimiter of the list: '" + delimiter + "'";
+            return false;
+        }
+        skipSpaces(false);
+        if (isEnd()) {
+            errorMsg = "Missing the closing bracket of the array";
+            return false;
+        }
+        if (buf[pos] == ']') {
+            pos++;
+            return true;
+        }
+        if (buf[pos] != ',') {
+            errorMsg = "Expected ',' or ']'";
+            return false;
+        }
+        pos++;
+        if (delimiter.empty()) {
+            errorMsg = "Multiple values are not allowed";
+            return false;
+        }
+        valueBuf.append(delimiter);
+    }
+}
+
+bool paramkit::util::ConfigReader::readJson(ConfigHandler &handler, std::vector<ConfigError> &errors)
+{
+    skipSpaces(false);
+    if (isEnd() || buf[pos] != '{') {
+        errors.push_back(ConfigError(line, column(), "Expected '{'"));
+        return false;
+    }
+    pos++;
+    bool isOk = true;
+    bool isFirst = true;
+    std::string errorMsg;
+    while (true) {
+        skipSpaces(false);
+        if (isEnd()) {
+            errors.push_back(ConfigError(line, column(), "Missing the closing brace of the object"));
+            return false;
+        }
+        if (buf[pos] == '}') {
+            pos++;
+            break;
+        }
+        if (!isFirst) {
+            if (buf[pos] != ',') {
+                errors.push_back(ConfigError(line, column(), "Expected ',' or '}'"));
+                return false;
+            }
+            pos++;
+            skipSpaces(false);
+        }
+        isFirst = false;
+
+        if (isEnd() || buf[pos] != '"') {
+            errors.push_back(ConfigError(line, column(), "Expected the key"));
+            return false;
+        }
+        const size_t keyLine = line;
+        const size_t keyColumn = column();
+        const size_t keyStart = pos + 1;
+        // the keys are the names of the parameters, so they are not unescaped:
+        if (!readJsonString(nullptr, errorMsg)) {
+            errors.push_back(ConfigError(line, column(), errorMsg));
+            return false;
+        }
+        const StringView key(buf + keyStart, pos - 1 - keyStart);
+
+        skipSpaces(false);
+        if (isEnd() || buf[pos] != ':') {
+            errors.push_back(ConfigError(line, column(), "Expected ':'"));
+            return false;
+        }
+        pos++;
+        skipSpaces(false);
+
+        bool isNull = false;
+        if (!readJsonValue(handler, key, isNull, errorMsg)) {
+            errors.push_back(ConfigError(line, column(), errorMsg));
+            return false;
+        }
+        if (!dispatch(handler, key, isNull ? nullptr : valueBuf.c_str(), keyLine, keyColumn, errors)) {
+            isOk = false;
+        }
+    }
+    skipSpaces(false);
+    if (!isEnd()) {
+        errors.push_back(ConfigError(line, column(), "Unexpected characters after the object"));
+        return false;
+    }
+    return isOk;
+}
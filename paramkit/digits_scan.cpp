@@ -0,0 +1,258 @@
+#include "pk_util.h"
+
+// Classification of the characters in numeric strings: vectorized kernels, selected at runtime
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PK_HAS_SSE2
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PK_TARGET_AVX2
+#define PK_HAS_AVX2
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define PK_TARGET_AVX2 __attribute__((target("avx2")))
+#define PK_HAS_AVX2
+#endif
+
+#endif // SSE2
+
+namespace {
+
+    using namespace paramkit;
+
+    typedef int(*scan_digits_func)(const char *buf, size_t len);
+
+    int scan_digits_scalar(const char *buf, size_t len)
+    {
+        int flags = DIGITS_DEC | DIGITS_HEX;
+        for (size_t i = 0; i < len; i++) {
+            const char c = buf[i];
+            if (c >= '0' && c <= '9') continue;
+            flags &= ~DIGITS_DEC;
+            if (c >= 'A' && c <= 'F') continue;
+            if (c >= 'a' && c <= 'f') continue;
+            return DIGITS_NONE;
+        }
+        return flags;
+    }
+
+#ifdef PK_HAS_SSE2
+    int scan_digits_sse2(const char *buf, size_t len)
+    {
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        const __m128i aChar = _mm_set1_epi8('a');
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i maxDigit = _mm_set1_epi8(9);
+        const __m128i maxLetter = _mm_set1_epi8(5);
+        const int allSet = 0xFFFF;
+
+        int flags = DIGITS_DEC | DIGITS_HEX;
+        size_t i = 0;
+        for (; i + sizeof(__m128i) <= len; i += sizeof(__m128i)) {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)(buf + i));
+            // unsigned (c - '0') <= 9
+            const __m128i digit = _mm_sub_epi8(chunk, zeroChar);
+            const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, maxDigit), digit);
+            // unsigned ((c | 0x20) - 'a') <= 5
+            const __m128i letter = _mm_sub_epi8(_mm_or_si128(chunk, caseBit), aChar);
+            const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, maxLetter), letter);
+
+            if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != allSet) {
+                return DIGITS_NONE;
+            }
+            if (_mm_movemask_epi8(isDigit) != allSet) {
+                flags &= ~DIGITS_DEC;
+            }
+        }
+        return flags & scan_digits_scalar(buf + i, len - i);
+    }
+#endif // PK_HAS_SSE2
+
+#ifdef PK_HAS_AVX2
+    PK_TARGET_AVX2 int scan_digits_avx2(const char *buf, size_t len)
+    {
+        const __m256i zeroChar = _mm256_set1_epi8('0');
+        const __m256i aChar = _mm256_set1_epi8('a');
+        const __m256i caseBit = _mm256_set1_epi8(0x20);
+        const __m256i maxDigit = _mm256_set1_epi8(9);
+        const __m256i maxLetter = _mm256_set1_epi8(5);
+        const int allSet = -1;
+
+        int flags = DIGITS_DEC | DIGITS_HEX;
+        size_t i = 0;
+        for (; i + sizeof(__m256i) <= len; i += sizeof(__m256i)) {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(buf + i));
+            const __m256i digit = _mm256_sub_epi8(chunk, zeroChar);
+            const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, maxDigit), digit);
+            const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chunk, caseBit), aChar);
+            const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, maxLetter), letter);
+
+            if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) != allSet) {
+                return DIGITS_NONE;
+            }
+            if (_mm256_movemask_epi8(isDigit) != allSet) {
+                flags &= ~DIGITS_DEC;
+            }
+        }
+        return flags & scan_digits_sse2(buf + i, len - i);
+    }
+
+    bool is_avx2_supported()
+    {
+        unsigned int regs[4] = { 0 }; // eax, ebx, ecx, edx
+#if defined(_MSC_VER)
+        int info[4] = { 0 };
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        regs[2] = info[2];
+#else
+        if (__get_cpuid_max(0, nullptr) < 7) return false;
+        __cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        const unsigned int OSXSAVE = 1 << 27;
+        if (!(regs[2] & OSXSAVE)) return false;
+
+        // the OS must preserve the YMM registers:
+#if defined(_MSC_VER)
+        const unsigned long long xcr0 = _xgetbv(0);
+#else
+        unsigned int xcr0_lo = 0, xcr0_hi = 0;
+        __asm__ volatile ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        const unsigned long long xcr0 = xcr0_lo;
+#endif
+        if ((xcr0 & 0x6) != 0x6) return false;
+
+#if defined(_MSC_VER)
+        __cpuidex(info, 7, 0);
+        regs[1] = info[1];
+#else
+        __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        const unsigned int AVX2 = 1 << 5;
+        return (regs[1] & AVX2) != 0;
+    }
+
+    //! Checks if the AVX2 is supported: the CPU is queried only once, as CPUID is expensive (i.e. it traps under the virtualization)
+    bool is_avx2_available()
+    {
+        static const bool isAvailable = is_avx2_supported();
+        return isAvailable;
+    }
+#endif // PK_HAS_AVX2
+
+    scan_digits_func select_scan_digits()
+    {
+#ifdef PK_HAS_AVX2
+        if (is_avx2_available()) {
+            return scan_digits_avx2;
+        }
+#endif
+#ifdef PK_HAS_SSE2
+        return scan_digits_sse2;
+#else
+        return scan_digits_scalar;
+#endif
+    }
+
+}; // anonymous namespace
+
+int paramkit::scan_digits(const char *buf, size_t len)
+{
+    if (!buf || len == 0) return DIGITS_NONE;
+
+    const size_t MIN_VECTOR_LEN = 16;
+    if (len < MIN_VECTOR_LEN) {
+        return scan_digits_scalar(buf, len);
+    }
+    static const scan_digits_func scan_func = select_scan_digits();
+    return scan_func(buf, len);
+}
+
+bool paramkit::detect_number_base(const char *buf, size_t len, OUT t_num_base &base)
+{
+    if (!buf || len == 0) return false;
+
+    const size_t prefixLen = 2;
+    if (len > prefixLen && buf[0] == '0' && (buf[1] == 'x' || buf[1] == 'X')) {
+        if (scan_digits(buf + prefixLen, len - prefixLen) & DIGITS_HEX) {
+            base = NUM_BASE_HEX;
+            return true;
+        }
+        return false;
+    }
+    if (scan_digits(buf, len) & DIGITS_DEC) {
+        base = NUM_BASE_DEC;
+        return true;
+    }
+    return false;
+}
+
+bool paramkit::scan_digits_with(t_scan_impl impl, const char *buf, size_t len, OUT int &flags)
+{
+    switch (impl) {
+    case SCAN_IMPL_AUTO:
+        flags = scan_digits(buf, len);
+        return true;
+    case SCAN_IMPL_SCALAR:
+        flags = scan_digits_scalar(buf, len);
+        return true;
+#ifdef PK_HAS_SSE2
+    case SCAN_IMPL_SSE2:
+        flags = scan_digits_sse2(buf, len);
+        return true;
+#endif
+#ifdef PK_HAS_AVX2
+    case SCAN_IMPL_AVX2:
+        if (!is_avx2_available()) return false;
+        flags = scan_digits_avx2(buf, len);
+        return true;
+#endif
+    default:
+        break;
+    }
+    return false;
+}
+
+bool paramkit::load_number(IN const char *str, IN size_t len, OUT uint64_t &out, IN t_num_base base)
+{
+    if (!str) return false;
+    bool isHex = (base == NUM_BASE_HEX);
+    if (base != NUM_BASE_DEC && len >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        isHex = true;
+        str += 2;
+        len -= 2;
+    }
+    if (len == 0) return false;
+
+    // validate all the digits at once:
+    if (!(scan_digits(str, len) & (isHex ? DIGITS_HEX : DIGITS_DEC))) {
+        return false;
+    }
+    uint64_t val = 0;
+    if (isHex) {
+        // skip the leading zeros: then, up to 16 digits fit
+        while (len > 1 && str[0] == '0') {
+            str++;
+            len--;
+        }
+        if (len > 16) return false; // overflow
+        for (size_t i = 0; i < len; i++) {
+            const char c = str[i];
+            const uint64_t digit = (c <= '9') ? (uint64_t)(c - '0') : (uint64_t)((c | 0x20) - 'a' + 10);
+            val = (val << 4) | digit;
+        }
+    }
+    else {
+        for (size_t i = 0; i < len; i++) {
+            const uint64_t digit = (uint64_t)(str[i] - '0');
+            if (val > (UINT64_MAX - digit) / 10) return false; // overflow
+            val = val * 10 + digit;
+        }
+    }
+    out = val;
+    return true;
+}
@@ -0,0 +1,112 @@
+/**
+* @file
+* @brief   The monotonic arena: allocates objects in big blocks, and releases all of them at once
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace paramkit {
+
+    namespace util {
+
+        //! The monotonic arena. The memory is taken from the blocks in sequence, and never reused, until the whole arena is released.
+        /**
+        The objects created in the arena are destroyed (in the reverse order of the creation) when the arena is released.
+        Optionally, the first block may be supplied by the caller (i.e. a buffer on the stack): then the heap is used only when it runs out.
+        */
+        class MonotonicArena {
+        public:
+            static const size_t DEFAULT_BLOCK_SIZE = 0x10000;
+
+            //! A constructor of the arena
+            /**
+            \param _blockSize : the size of the blocks that are allocated on the heap
+            \param initialBuffer : an optional buffer, supplied by the caller, that will be used before allocating any blocks. It must outlive the arena.
+            \param initialSize : the size of the initialBuffer
+            */
+            MonotonicArena(size_t _blockSize = DEFAULT_BLOCK_SIZE, void *initialBuffer = nullptr, size_t initialSize = 0)
+                : blockSize(_blockSize), initialBuf(static_cast<char*>(initialBuffer)), initialBufSize(initialBuffer ? initialSize : 0),
+                current(nullptr), currentEnd(nullptr), allocatedTotal(0)
+            {
+                resetCurrent();
+            }
+
+            ~MonotonicArena()
+            {
+                release();
+            }
+
+            //! Allocates the memory of the given size and alignment. The memory cannot be freed separately.
+            void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+            //! Creates an object of the type T in the arena. The object is destroyed when the arena is released.
+            template <class T, class... Args>
+            T* create(Args&&... args)
+            {
+                void *mem = allocate(sizeof(T), alignof(T));
+                T *obj = new (mem) T(std::forward<Args>(args)...);
+                objects.push_back(std::make_pair(static_cast<void*>(obj), &destroyObject<T>));
+                return obj;
+            }
+
+            //! Checks if the given memory was allocated in this arena
+            bool owns(const void *ptr) const;
+
+            //! Destroys all the created objects, and frees all the allocated blocks
+            void release();
+
+            //! Returns the number of the blocks allocated on the heap
+            size_t blocksCount() const
+            {
+                return blocks.size();
+            }
+
+            //! Returns the total size of the blocks allocated on the heap
+            size_t allocatedSize() const
+            {
+                return allocatedTotal;
+            }
+
+        protected:
+            typedef void (*t_destructor)(void *obj);
+
+            template <class T>
+            static void destroyObject(void *obj)
+            {
+                static_cast<T*>(obj)->~T();
+            }
+
+            struct Block {
+                char *start;
+                size_t size;
+            };
+
+            void resetCurrent()
+            {
+                current = initialBuf;
+                currentEnd = initialBuf + initialBufSize;
+            }
+
+            //! Returns the pointer aligned up to the given alignment, or nullptr if the aligned allocation doesn't fit in the current block
+            char* fitCurrent(size_t size, size_t alignment) const;
+
+            const size_t blockSize;
+            char *initialBuf;
+            const size_t initialBufSize;
+
+            char *current; ///< the first free byte of the current block
+            char *currentEnd; ///< the end of the current block
+            size_t allocatedTotal;
+
+            std::vector<Block> blocks;
+            std::vector<std::pair<void*, t_destructor> > objects; ///< the created objects, along with their destructors
+        };
+
+    }; //namespace util
+
+}; //namespace paramkit
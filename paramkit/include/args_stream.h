@@ -0,0 +1,177 @@
+/**
+* @file
+* @brief   The stream of the arguments passed to the parser: from argv, with the optional expansion of the @response-files
+*/
+
+#pragma once
+
+#include <string>
+#include <iterator>
+#include <cstring>
+
+#include "pk_util.h"
+#include "cmdline_tokenizer.h"
+#include "mapped_file.h"
+
+#define RESPONSE_FILE_PREFIX '@'
+
+namespace paramkit {
+
+    //! The stream of the arguments. The arguments given in argv are passed as they are, without copying.
+    /**
+    If the expansion of the response files is enabled, an argument in the form @<path> is replaced by the arguments read from the file (if such file exists).
+    The file is mapped into the memory, and tokenized lazily, one argument at a time, so the file of any size is read in bounded memory.
+    The arguments read from the file are not expanded recursively.
+    With the Windows rules, each line of the file is split as a separate command line (the quotes don't continue to the next line).
+    The file is read as UTF-8: for the wide arguments, it is decoded.
+    */
+    template <typename T_CHAR>
+    class ArgsStream {
+    public:
+        //! A constructor of the stream
+        /**
+        \param _argc : the number of the arguments
+        \param _argv : the arguments (the first of them is skipped, as it is the name of the program)
+        \param _expandFiles : if set, the @response-files are expanded
+        \param _fileStyle : the rules by which the response files are split into the arguments
+        */
+        ArgsStream(int _argc, T_CHAR* _argv[], bool _expandFiles = false, t_cmdline_style _fileStyle = CMDLINE_NATIVE)
+            : argc(_argc), argv(_argv), argvPos(1), expandFiles(_expandFiles), fileStyle(_fileStyle), filePos(0), lineEnd(0), isLineKnown(false), fileArgIndex(0),
+            curBuf(0), peekedBuf(1), peekedArg(nullptr), peekedIndex(0), hasPeeked(false), curIndex(0)
+        {
+        }
+
+        //! Returns the next argument, or nullptr if there are no more. The returned string is valid until the next call of next().
+        const T_CHAR* next()
+        {
+            peek();
+            hasPeeked = false;
+            curBuf = peekedBuf;
+            curIndex = peekedIndex;
+            return peekedArg;
+        }
+
+        //! Returns the next argument without consuming it, or nullptr if there are no more. The returned string is valid until the next call of next().
+        const T_CHAR* peek()
+        {
+            if (!hasPeeked) {
+                peekedBuf = 1 - curBuf; // don't overwrite the current argument
+                peekedArg = read(peekedIndex, bufs[peekedBuf]);
+                hasPeeked = true;
+            }
+            return peekedArg;
+        }
+
+        //! Returns the index (in argv) of the argument returned by the last call of next(). For the arguments read from a response file, it is the index of the file.
+        int argIndex() const
+        {
+            return curIndex;
+        }
+
+    protected:
+        const T_CHAR* read(int &index, std::basic_string<T_CHAR> &buf)
+        {
+            while (true) {
+                if (file.isOpen()) {
+                    if (readFromFile(buf)) {
+                        index = fileArgIndex;
+                        return buf.c_str();
+                    }
+                    file.close();
+                    continue;
+                }
+                if (argvPos >= argc) {
+                    return nullptr;
+                }
+                index = argvPos;
+                const T_CHAR *arg = argv[argvPos++];
+                if (expandFiles && arg && arg[0] == RESPONSE_FILE_PREFIX && arg[1] != 0) {
+                    if (file.open(std::basic_string<T_CHAR>(arg + 1))) {
+                        fileArgIndex = index;
+                        filePos = 0;
+                        isLineKnown = false;
+                        skipBom();
+                        continue;
+                    }
+                }
+                return arg;
+            }
+        }
+
+        bool readFromFile(std::string &buf)
+        {
+            return tokenizeFile(buf);
+        }
+
+        bool readFromFile(std::wstring &buf)
+        {
+            if (!tokenizeFile(narrowBuf)) {
+                return false;
+            }
+            buf.clear();
+            util::append_utf8(narrowBuf.c_str(), narrowBuf.length(), buf);
+            return true;
+        }
+
+        //! Reads the next argument from the response file, as it is stored in the file (UTF-8)
+        bool tokenizeFile(std::string &buf)
+        {
+            buf.clear();
+            std::back_insert_iterator<std::string> out(buf);
+            std::back_insert_iterator<std::string> outStart(buf);
+            if (fileStyle != CMDLINE_WINDOWS) {
+                return CmdlineTokenizer<char>::readArg(file.data(), file.size(), filePos, fileStyle, false, out, outStart);
+            }
+            // the line breaks are not the separators in the Windows rules: split each line separately
+            while (filePos < file.size()) {
+                if (!isLineKnown) {
+                    const char *found = static_cast<const char*>(memchr(file.data() + filePos, '\n', file.size() - filePos));
+                    lineEnd = found ? (size_t)(found - file.data()) : file.size();
+                    isLineKnown = true;
+                }
+                size_t argsEnd = lineEnd;
+                if (argsEnd > filePos && file.data()[argsEnd - 1] == '\r') {
+                    argsEnd--;
+                }
+                if (CmdlineTokenizer<char>::readArg(file.data(), argsEnd, filePos, fileStyle, false, out, outStart)) {
+                    return true;
+                }
+                filePos = lineEnd + 1; // skip the line break
+                isLineKnown = false;
+            }
+            return false;
+        }
+
+        //! Skips the UTF-8 BOM at the start of the file
+        void skipBom()
+        {
+            const char bom[] = "\xEF\xBB\xBF";
+            const size_t bomLen = sizeof(bom) - 1;
+            if (file.size() >= bomLen && memcmp(file.data(), bom, bomLen) == 0) {
+                filePos = bomLen;
+            }
+        }
+
+        const int argc;
+        T_CHAR **argv;
+        int argvPos; ///< the index of the next argument to be read from argv
+
+        const bool expandFiles;
+        const t_cmdline_style fileStyle;
+        util::MappedFile file; ///< the response file that is currently read
+        size_t filePos;
+        size_t lineEnd; ///< the end of the line that is currently read (with the Windows rules)
+        bool isLineKnown; ///< true if the lineEnd is found for the current line
+        int fileArgIndex; ///< the index (in argv) of the response file that is currently read
+
+        std::basic_string<T_CHAR> bufs[2]; ///< the buffers of the arguments read from the files: the current one, and the peeked one
+        std::string narrowBuf; ///< the argument read from the file before it is decoded into the wide buffer
+        size_t curBuf;
+        size_t peekedBuf;
+        const T_CHAR *peekedArg;
+        int peekedIndex;
+        bool hasPeeked;
+        int curIndex;
+    };
+
+};
@@ -0,0 +1,253 @@
+/**
+* @file
+* @brief   Splitting the raw command line into the arguments, following the quoting rules of Windows or POSIX
+*/
+
+#pragma once
+
+#include <vector>
+#include <stddef.h>
+
+namespace paramkit {
+
+    //! The rules by which the command line is split into the arguments
+    typedef enum {
+        CMDLINE_WINDOWS = 0, ///< the rules of the MSVC runtime (since 2008): the arguments are separated by spaces and tabs, quoted with '"', and the backslashes escape the quotes
+        CMDLINE_POSIX, ///< the quoting of the POSIX shell: '...' and "...", and backslash escapes (no expansions are done). The arguments are separated by spaces, tabs, and line breaks (also CR, so that the CRLF files are accepted)
+        CMDLINE_NUL_SEPARATED, ///< the arguments are separated by NUL characters, as in /proc/<pid>/cmdline
+        CMDLINE_STYLES_COUNT
+    } t_cmdline_style;
+
+#ifdef _WIN32
+    const t_cmdline_style CMDLINE_NATIVE = CMDLINE_WINDOWS;
+#else
+    const t_cmdline_style CMDLINE_NATIVE = CMDLINE_POSIX;
+#endif
+
+    //! Splits the command line into the arguments. The command line is tokenized in place: the arguments are unescaped and terminated inside the given buffer, so nothing is copied.
+    template <typename T_CHAR>
+    class CmdlineTokenizer {
+    public:
+        //! A constructor of the tokenizer
+        /**
+        \param _buf : the command line: a writeable buffer that is NUL-terminated (buf[len] must be 0). It is modified by the tokenizer.
+        \param _len : the length of the command line (without the terminating NUL)
+        \param _style : the quoting rules
+        */
+        CmdlineTokenizer(T_CHAR *_buf, size_t _len, t_cmdline_style _style = CMDLINE_NATIVE)
+            : buf(_buf), len(_buf ? _len : 0), pos(0), style(_style), isFirst(true)
+        {
+        }
+
+        //! Returns the next argument: a NUL-terminated string inside the buffer, or nullptr if there are no more arguments
+        T_CHAR* next()
+        {
+            // the unescaped argument is never longer than its raw form, so it can be written over it
+            T_CHAR *out = buf + pos;
+            T_CHAR *start = out;
+            if (!readArg(buf, len, pos, style, isFirst, out, start)) {
+                return nullptr;
+            }
+            isFirst = false;
+            *out = 0;
+            return start;
+        }
+
+        //! Splits the whole remaining command line, appending the arguments to the vector. Returns the number of the added arguments.
+        size_t tokenize(std::vector<T_CHAR*> &argv)
+        {
+            size_t count = 0;
+            T_CHAR *arg = nullptr;
+            while ((arg = next()) != nullptr) {
+                argv.push_back(arg);
+                count++;
+            }
+            return count;
+        }
+
+        //! Reads the next argument from the buffer, starting at the given position, and writes its unescaped content via the output iterator.
+        /**
+        \param in : the buffer with the command line
+        \param inLen : the length of the buffer
+        \param inPos : the current position in the buffer: moved past the read argument
+        \param style : the quoting rules
+        \param isFirstArg : true if this is the first argument (the program name), that has special rules on Windows
+        \param out : the output iterator, receiving the characters of the argument. It may write over the buffer, as it never outruns the reading.
+        \param outStart : filled with the output iterator at the start of the argument (before anything was written)
+        \return true if an argument was found (it may be empty, i.e. given as ""), false if the end of the buffer was reached
+        */
+        template <typename OUT_ITER>
+        static bool readArg(const T_CHAR *in, size_t inLen, size_t &inPos, t_cmdline_style style, bool isFirstArg, OUT_ITER &out, OUT_ITER &outStart)
+        {
+            if (style == CMDLINE_NUL_SEPARATED) {
+                if (inPos >= inLen) return false;
+                outStart = out;
+                while (inPos < inLen && in[inPos] != 0) {
+                    *out = in[inPos++]; ++out;
+                }
+                inPos++; // skip the separator
+                return true;
+            }
+            // skip the whitespaces before the argument (and the POSIX line continuations, that are not a part of any argument):
+            while (inPos < inLen) {
+                if (isSeparator(in[inPos], style)) {
+                    inPos++;
+                }
+                else if (style == CMDLINE_POSIX && in[inPos] == '\\' && (inPos + 1) < inLen && in[inPos + 1] == '\n') {
+                    inPos += 2;
+                }
+                else break;
+            }
+            if (inPos >= inLen || in[inPos] == 0) {
+                inPos = inLen;
+                return false;
+            }
+            outStart = out;
+            if (style == CMDLINE_WINDOWS) {
+                if (isFirstArg) {
+                    readProgramNameWin(in, inLen, inPos, out);
+                }
+                else {
+                    readArgWin(in, inLen, inPos, out);
+                }
+            }
+            else {
+                readArgPosix(in, inLen, inPos, out);
+            }
+            // consume the separator, so that it can be overwritten by the terminator of the argument
+            if (inPos < inLen && isSeparator(in[inPos], style)) inPos++;
+            return true;
+        }
+
+    protected:
+        //! Checks if the character separates the arguments: on Windows only the spaces and tabs do, the line breaks are a part of the argument
+        static bool isSeparator(T_CHAR c, t_cmdline_style style)
+        {
+            if (c == ' ' || c == '\t') return true;
+            if (style == CMDLINE_POSIX) {
+                return c == '\n' || c == '\r';
+            }
+            return false;
+        }
+
+        //! The program name: the quotes are toggling the quoted mode, and the backslashes are literal
+        template <typename OUT_ITER>
+        static void readProgramNameWin(const T_CHAR *in, size_t inLen, size_t &inPos, OUT_ITER &out)
+        {
+            bool isQuoted = false;
+            for (; inPos < inLen && in[inPos] != 0; inPos++) {
+                const T_CHAR c = in[inPos];
+                if (c == '"') {
+                    isQuoted = !isQuoted;
+                    continue;
+                }
+                if (!isQuoted && isSeparator(c, CMDLINE_WINDOWS)) break;
+                *out = c; ++out;
+            }
+        }
+
+        //! The rules of the MSVC runtime since 2008 (the argv passed to main).
+        /**
+        A doubled quote inside the quoted part gives a literal quote, and the quoted part continues: "a""b c" is a single argument: a"b c.
+        CommandLineToArgvW (as the older runtimes) differs in this case only: it ends the quoted part after the literal quote, giving: a"b, c.
+        */
+        template <typename OUT_ITER>
+        static void readArgWin(const T_CHAR *in, size_t inLen, size_t &inPos, OUT_ITER &out)
+        {
+            bool isQuoted = false;
+            while (inPos < inLen && in[inPos] != 0) {
+                const T_CHAR c = in[inPos];
+                if (!isQuoted && isSeparator(c, CMDLINE_WINDOWS)) break;
+
+                if (c == '\\') {
+                    size_t slashes = 0;
+                    while (inPos < inLen && in[inPos] == '\\') {
+                        slashes++;
+                        inPos++;
+                    }
+                    const bool isBeforeQuote = (inPos < inLen && in[inPos] == '"');
+                    // before a quote: 2n backslashes give n, 2n+1 give n and the literal quote
+                    const size_t literalSlashes = isBeforeQuote ? (slashes / 2) : slashes;
+                    for (size_t i = 0; i < literalSlashes; i++) {
+                        *out = '\\'; ++out;
+                    }
+                    if (isBeforeQuote && (slashes % 2)) {
+                        *out = '"'; ++out;
+                        inPos++;
+                    }
+                    continue;
+                }
+                if (c == '"') {
+                    inPos++;
+                    if (isQuoted && inPos < inLen && in[inPos] == '"') {
+                        // the doubled quote inside the quoted part gives the literal quote, staying in the quoted part
+                        *out = '"'; ++out;
+                        inPos++;
+                        continue;
+                    }
+                    isQuoted = !isQuoted;
+                    continue;
+                }
+                *out = c; ++out;
+                inPos++;
+            }
+        }
+
+        //! The quoting of the POSIX shell, without any expansions
+        template <typename OUT_ITER>
+        static void readArgPosix(const T_CHAR *in, size_t inLen, size_t &inPos, OUT_ITER &out)
+        {
+            while (inPos < inLen && in[inPos] != 0) {
+                const T_CHAR c = in[inPos];
+                if (isSeparator(c, CMDLINE_POSIX)) break;
+
+                if (c == '\\') {
+                    inPos++;
+                    if (inPos >= inLen || in[inPos] == 0) break;
+                    if (in[inPos] != '\n') { // backslash-newline is a line continuation
+                        *out = in[inPos]; ++out;
+                    }
+                    inPos++;
+                    continue;
+                }
+                if (c == '\'') {
+                    // everything is literal until the closing quote
+                    for (inPos++; inPos < inLen && in[inPos] != 0 && in[inPos] != '\''; inPos++) {
+                        *out = in[inPos]; ++out;
+                    }
+                    if (inPos < inLen && in[inPos] == '\'') inPos++;
+                    continue;
+                }
+                if (c == '"') {
+                    for (inPos++; inPos < inLen && in[inPos] != 0 && in[inPos] != '"'; inPos++) {
+                        T_CHAR qc = in[inPos];
+                        if (qc == '\\' && (inPos + 1) < inLen) {
+                            const T_CHAR escaped = in[inPos + 1];
+                            // inside the double quotes, the backslash escapes only the special characters
+                            if (escaped == '"' || escaped == '\\' || escaped == '$' || escaped == '`') {
+                                qc = escaped;
+                                inPos++;
+                            }
+                            else if (escaped == '\n') {
+                                inPos++;
+                                continue;
+                            }
+                        }
+                        *out = qc; ++out;
+                    }
+                    if (inPos < inLen && in[inPos] == '"') inPos++;
+                    continue;
+                }
+                *out = c; ++out;
+                inPos++;
+            }
+        }
+
+        T_CHAR *buf;
+        const size_t len;
+        size_t pos;
+        const t_cmdline_style style;
+        bool isFirst;
+    };
+
+};
@@ -0,0 +1,89 @@
+/**
+* @file
+* @brief   The text with colored ranges, that can be built in memory and printed at once
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace paramkit {
+
+    //! The text along with the ranges of colors. Allows to render the output in memory, cache it, and print it at once.
+    class ColoredText {
+    public:
+        //! A range of the text printed in a color
+        struct ColorSpan {
+            size_t offset;
+            size_t length;
+            int color;
+        };
+
+        //! Appends the text printed in the default color
+        ColoredText& append(const std::string &str)
+        {
+            text += str;
+            return *this;
+        }
+
+        //! Appends the text printed in the given color
+        ColoredText& append(int color, const std::string &str)
+        {
+            if (str.empty()) return *this;
+
+            if (spans.size() && spans.back().color == color && (spans.back().offset + spans.back().length) == text.length()) {
+                spans.back().length += str.length(); // continuation of the previous span
+            }
+            else {
+                ColorSpan span;
+                span.offset = text.length();
+                span.length = str.length();
+                span.color = color;
+                spans.push_back(span);
+            }
+            text += str;
+            return *this;
+        }
+
+        //! Appends another colored text
+        ColoredText& append(const ColoredText &other)
+        {
+            const size_t base = text.length();
+            text += other.text;
+            for (std::vector<ColorSpan>::const_iterator itr = other.spans.begin(); itr != other.spans.end(); ++itr) {
+                ColorSpan span = *itr;
+                span.offset += base;
+                spans.push_back(span);
+            }
+            return *this;
+        }
+
+        void clear()
+        {
+            text.clear();
+            spans.clear();
+        }
+
+        bool empty() const
+        {
+            return text.empty();
+        }
+
+        //! Returns the text, without the colors
+        const std::string& str() const
+        {
+            return text;
+        }
+
+        const std::vector<ColorSpan>& colorSpans() const
+        {
+            return spans;
+        }
+
+    protected:
+        std::string text;
+        std::vector<ColorSpan> spans; ///< the colored ranges of the text, sorted by offsets, not overlapping
+    };
+
+};
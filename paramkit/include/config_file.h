@@ -0,0 +1,135 @@
+/**
+* @file
+* @brief   Reading the configuration files: in the INI (key=value) format, or in a subset of JSON
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+
+#include "span.h"
+
+namespace paramkit {
+
+    //! The format of the configuration file
+    typedef enum {
+        CONFIG_AUTO = 0, ///< detected by the content: JSON if the first non-whitespace character is '{', INI otherwise
+        CONFIG_INI, ///< the lines in the form: key = value; the sections: [name]; the comments starting with ';' or '#' (after an unquoted value: if preceded by a whitespace)
+        CONFIG_JSON, ///< a single object, with the values being: strings, numbers, true/false, null, or arrays of them (joined into a list)
+        CONFIG_FORMATS_COUNT
+    } t_config_format;
+
+    //! The problem found while reading the configuration. The line and the column are counted from 1 (the column in bytes).
+    struct ConfigError {
+        ConfigError(size_t _line, size_t _column, const std::string &_message)
+            : line(_line), column(_column), message(_message)
+        {
+        }
+
+        size_t line;
+        size_t column;
+        std::string message;
+    };
+
+    namespace util {
+
+        //! Receives the entries read from the configuration
+        class ConfigHandler {
+        public:
+            virtual ~ConfigHandler() {}
+
+            //! Called for each entry of the configuration.
+            /**
+            \param key : the name of the entry
+            \param value : the NUL-terminated value, valid only during the call; or nullptr if the key was given without a value (INI: the bare key; JSON: null)
+            \param errorMsg : to be filled with the description of the problem, if the entry was not accepted
+            \return true if the entry was accepted, false otherwise
+            */
+            virtual bool onEntry(const StringView &key, const char *value, std::string &errorMsg) = 0;
+
+            //! Called for the array (JSON), to get the separator with which its elements are joined into the value of the entry
+            /**
+            \param key : the name of the entry
+            \return the separator: the elements must not contain it. If it is empty, the array can't have more than one element.
+            */
+            virtual std::string listDelimiter(const StringView & /*key*/)
+            {
+                return ",";
+            }
+        };
+
+        //! Reads the configuration from the buffer in a single pass, passing the entries to the handler.
+        /**
+        The keys are passed as the views into the buffer. The values are passed via a single buffer, that is reused for all the entries, so no allocation is done per line.
+        The INI sections are accepted, but they don't change the meaning of the keys.
+        */
+        class ConfigReader {
+        public:
+            ConfigReader(const char *_buf, size_t _len, t_config_format _format = CONFIG_AUTO)
+                : buf(_buf), len(_buf ? _len : 0), format(_format), pos(0), line(1), lineStart(0)
+            {
+            }
+
+            //! Reads all the entries. The problems are appended to the errors. Returns true if no problems were found.
+            bool read(ConfigHandler &handler, std::vector<ConfigError> &errors);
+
+        protected:
+            bool readIni(ConfigHandler &handler, std::vector<ConfigError> &errors);
+            bool readJson(ConfigHandler &handler, std::vector<ConfigError> &errors);
+
+            //! Passes the entry to the handler, and records the error if it was not accepted
+            bool dispatch(ConfigHandler &handler, const StringView &key, const char *value, size_t keyLine, size_t keyColumn, std::vector<ConfigError> &errors);
+
+            //! INI: reads the value that follows the '=' till the end of the line, into the valueBuf
+            bool readIniValue(std::string &errorMsg);
+
+            //! JSON: reads the quoted string. If out is given, the unescaped content is appended to it.
+            bool readJsonString(std::string *out, std::string &errorMsg);
+
+            //! JSON: reads the 4 hexadecimal digits of the \u escape sequence
+            bool readJsonHex4(unsigned long &code, std::string &errorMsg);
+
+            //! JSON: reads the scalar value (a string, a number, true/false, or null), appending it to the valueBuf. Sets isNull if null was read.
+            bool readJsonScalar(bool &isNull, std::string &errorMsg);
+
+            //! JSON: reads the value, which may be an array of the scalars: then the elements are joined with the delimiter given by the handler
+            bool readJsonValue(ConfigHandler &handler, const StringView &key, bool &isNull, std::string &errorMsg);
+
+            void skipBom();
+
+            //! Skips the whitespaces, counting the lines. If stopAtNewLine is set, stops at the end of the line.
+            void skipSpaces(bool stopAtNewLine);
+
+            void skipLine();
+
+            void newLine()
+            {
+                line++;
+                lineStart = pos;
+            }
+
+            size_t column() const
+            {
+                return pos - lineStart + 1;
+            }
+
+            bool isEnd() const
+            {
+                return pos >= len;
+            }
+
+            const char *buf;
+            const size_t len;
+            const t_config_format format;
+
+            size_t pos;
+            size_t line;
+            size_t lineStart; ///< the offset at which the current line starts
+            std::string valueBuf; ///< the NUL-terminated value of the current entry: reused for all of them
+        };
+
+    }; //namespace util
+
+}; //namespace paramkit
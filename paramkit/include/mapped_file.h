@@ -0,0 +1,66 @@
+/**
+* @file
+* @brief   The read-only view of a file mapped into the memory
+*/
+
+#pragma once
+
+#include <string>
+#include <stddef.h>
+
+namespace paramkit {
+
+    namespace util {
+
+        //! The file mapped into the memory, read-only. The pages are loaded on demand, and can be dropped by the system when the memory is needed, so the file of any size can be read in bounded memory.
+        class MappedFile {
+        public:
+            MappedFile()
+                : buf(nullptr), bufSize(0), mapping(nullptr), opened(false)
+            {
+            }
+
+            ~MappedFile()
+            {
+                close();
+            }
+
+            //! Maps the file with the given path. Returns false if the file could not be opened or mapped.
+            bool open(const std::string &path);
+
+            //! Maps the file with the given wide path: opened as it is on Windows, and encoded in UTF-8 on the other systems
+            bool open(const std::wstring &path);
+
+            //! Unmaps the file
+            void close();
+
+            bool isOpen() const
+            {
+                return opened;
+            }
+
+            //! Returns the content of the file. Note that it is not NUL-terminated.
+            const char* data() const
+            {
+                return buf;
+            }
+
+            size_t size() const
+            {
+                return bufSize;
+            }
+
+        protected:
+            //! Copying is not allowed: the mapping is owned
+            MappedFile(const MappedFile&);
+            MappedFile& operator=(const MappedFile&);
+
+            const char *buf;
+            size_t bufSize;
+            void *mapping; ///< Windows only: the handle of the mapping
+            bool opened; ///< true if the file was opened (an empty file is opened, but not mapped)
+        };
+
+    }; //namespace util
+
+}; //namespace paramkit
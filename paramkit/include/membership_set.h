@@ -0,0 +1,129 @@
+/**
+* @file
+* @brief   The frozen set of numbers, answering the membership queries in constant time
+*/
+
+#pragma once
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace paramkit {
+
+    namespace util {
+
+        //! The set of numbers that is built once, and then only queried. The representation is chosen by the density of the values:
+        /**
+        - a bitmap: if the values are dense, within a small range,
+        - a sorted vector, searched without branches: if there are just a few values,
+        - an open-addressing hash table: otherwise.
+        */
+        class MembershipSet {
+        public:
+            //! The representation of the set
+            typedef enum {
+                SET_EMPTY = 0, ///< no values
+                SET_BITMAP, ///< a bit per each number within the range [minVal, maxVal]
+                SET_SORTED, ///< a sorted vector of the values
+                SET_HASHED, ///< an open-addressing hash table (linear probing)
+                SET_KINDS_COUNT
+            } t_set_kind;
+
+            //! The maximal number of the values kept in the sorted vector
+            static const size_t SORTED_MAX = 64;
+
+            //! The maximal range of the values kept in the bitmap (in bits)
+            static const uint64_t BITMAP_MAX_RANGE = (uint64_t)1 << 24;
+
+            MembershipSet()
+                : kind(SET_EMPTY), minVal(0), maxVal(0), valuesCount(0), hashShift(0), hasZero(false)
+            {
+            }
+
+            //! Builds the set from the given values (that may be unsorted, and contain the duplicates). The previous content is discarded.
+            void build(const uint64_t *values, size_t count);
+
+            void build(const std::vector<uint64_t> &values)
+            {
+                build(values.empty() ? nullptr : &values[0], values.size());
+            }
+
+            //! Empties the set
+            void clear();
+
+            //! Checks if the set contains the given value
+            bool contains(uint64_t val) const
+            {
+                if (kind == SET_EMPTY || val < minVal || val > maxVal) {
+                    return false;
+                }
+                if (kind == SET_BITMAP) {
+                    const uint64_t bit = val - minVal;
+                    return (words[(size_t)(bit >> 6)] >> (bit & 63)) & 1;
+                }
+                if (kind == SET_SORTED) {
+                    return containsSorted(val);
+                }
+                return containsHashed(val);
+            }
+
+            t_set_kind getKind() const
+            {
+                return kind;
+            }
+
+            //! The number of the distinct values in the set
+            size_t size() const
+            {
+                return valuesCount;
+            }
+
+        protected:
+            //! The branchless binary search: the comparison only selects the next base, so it compiles to a conditional move
+            bool containsSorted(uint64_t val) const
+            {
+                const uint64_t *base = &words[0];
+                size_t len = words.size();
+                while (len > 1) {
+                    const size_t half = len / 2;
+                    base = (base[half] <= val) ? (base + half) : base;
+                    len -= half;
+                }
+                return (*base == val);
+            }
+
+            bool containsHashed(uint64_t val) const
+            {
+                // the zero marks the empty slot, so it is stored aside:
+                if (val == 0) return hasZero;
+
+                const size_t mask = words.size() - 1;
+                for (size_t pos = hashSlot(val); ; pos = (pos + 1) & mask) {
+                    const uint64_t slot = words[pos];
+                    if (slot == val) return true;
+                    if (slot == 0) return false;
+                }
+            }
+
+            //! The Fibonacci hashing: the top bits of the product are well mixed
+            size_t hashSlot(uint64_t val) const
+            {
+                return (size_t)((val * 0x9E3779B97F4A7C15ULL) >> hashShift);
+            }
+
+            void buildBitmap(const std::vector<uint64_t> &sorted);
+            void buildHashed(const std::vector<uint64_t> &sorted);
+
+            t_set_kind kind;
+            uint64_t minVal;
+            uint64_t maxVal;
+            size_t valuesCount;
+            std::vector<uint64_t> words; ///< depending on the kind: the bitmap, the sorted values, or the slots of the hash table
+            unsigned int hashShift;
+            bool hasZero; ///< SET_HASHED only: true if the zero belongs to the set
+        };
+
+    }; //namespace util
+
+}; //namespace paramkit
@@ -5,16 +5,24 @@
 
 #pragma once
 
-#include <windows.h>
-
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <map>
 #include <set>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstring>
 
 #include "pk_util.h"
 #include "strings_util.h"
+#include "similarity_index.h"
+#include "colored_text.h"
+#include "pooled_string.h"
+#include "parsed_values.h"
+#include "span.h"
+#include "membership_set.h"
 
 #define PARAM_UNINITIALIZED (-1)
 #define INFO_SPACER "\t   "
@@ -22,10 +30,43 @@
 #define PARAM_SWITCH1 '/' ///< The switch used to recognize that the given string should be treated as a parameter (variant 1)
 #define PARAM_SWITCH2 '-' ///< The switch used to recognize that the given string should be treated as a parameter (variant 2)
 
-typedef unsigned __int64 uint64_t;
+#define INT_LIST_RANGE_SEPARATOR '-' ///< The separator of the range in the IntListParam, i.e. "1-5"
+#define INT_LIST_RANGE_MAX 0x10000 ///< The maximal number of the elements that a single range of the IntListParam can be expanded into
+#define INT_LIST_COUNT_MAX 0x100000 ///< The maximal number of the elements of the IntListParam, after all the ranges are expanded
 
 namespace paramkit {
 
+    //! Skip the parameter prefix. Example: "/param", '-param', or "--param" is converted to "param". Returns nullptr if the string is not a parameter.
+    template <typename T_CHAR>
+    const T_CHAR* skip_param_prefix(const T_CHAR *str)
+    {
+        if (!str || (str[0] != PARAM_SWITCH1 && str[0] != PARAM_SWITCH2) || str[1] == 0) {
+            return nullptr;
+        }
+        if (str[0] == PARAM_SWITCH2 && str[1] == PARAM_SWITCH2 && str[2] != 0) {
+            return str + 2; // double prefix: "--", i.e. "--param"
+        }
+        return str + 1; // skip the first char
+    }
+
+    class Param;
+
+    //! The interface of an object that is notified about the changes of the parameters (i.e. the container of the parameters)
+    class ParamListener {
+    public:
+        //! The kinds of the changes
+        typedef enum {
+            CHANGED_INFO = 0, ///< the description of the parameter has changed
+            CHANGED_ACTIVE = 1, ///< the parameter was activated or deactivated
+            CHANGED_VALUE = 2, ///< the value of the parameter was parsed or set
+            CHANGES_COUNT
+        } t_param_change;
+
+        virtual ~ParamListener() {}
+
+        virtual void onParamChanged(Param *param, t_param_change change) = 0;
+    };
+
     //! The base class of a parameter
     class Param {
     public:
@@ -39,8 +80,14 @@ namespace paramkit {
         {
             isRequired = _isRequired;
             argStr = _argStr;
+            nameCharset = util::CharsetSignature(argStr.c_str());
             requiredArg = false;
             active = true;
+            listener = nullptr;
+            countedSet = false;
+            countedActive = false;
+            denseId = 0;
+            inArena = false;
         }
 
         //! A constructor of a parameter
@@ -53,11 +100,19 @@ namespace paramkit {
         {
             isRequired = _isRequired;
             argStr = _argStr;
+            nameCharset = util::CharsetSignature(argStr.c_str());
             typeDescStr = _typeDescStr;
             requiredArg = false;
             active = true;
+            listener = nullptr;
+            countedSet = false;
+            countedActive = false;
+            denseId = 0;
+            inArena = false;
         }
 
+        virtual ~Param() {}
+
         //! Returns the string representation of the parameter's value
         virtual std::string valToString() const = 0;
 
@@ -67,17 +122,35 @@ namespace paramkit {
         //! Parses the parameter from the given string
         virtual bool parse(const char *arg) = 0;
 
-        //! Parses the parameter from the given wide string
+        //! Parses the parameter from the given wide string. The default implementation parses its narrow copy: for the short arguments, it is made without allocating.
         virtual bool parse(const wchar_t *arg)
         {
-            std::wstring value = arg;
-            std::string str(value.begin(), value.end());
+            const util::NarrowString str(arg);
             return parse(str.c_str());
         }
 
+        //! Parses the value from the given string into the external store, without modifying the parameter. Used to parse multiple command lines with the same schema.
+        /**
+        \param arg : the string to be parsed (nullptr if the parameter was given without a value)
+        \param out : the value to be filled. On success, its field isSet reflects isSet() of the parameter holding the same value.
+        \return true if parsing succeeded. The base implementation doesn't support the external store, so it always fails.
+        */
+        virtual bool parseValue(const char * /*arg*/, ParsedValue & /*out*/) const
+        {
+            return false;
+        }
+
+        //! Parses the value from the given wide string into the external store, without modifying the parameter
+        virtual bool parseValue(const wchar_t *arg, ParsedValue &out) const
+        {
+            const util::NarrowString str(arg);
+            return parseValue(str.c_str(), out);
+        }
+
         void setActive(bool _active)
         {
             this->active = _active;
+            notifyChanged(ParamListener::CHANGED_ACTIVE);
         }
 
         //! Returns true if the parameter is active, false otherwise.
@@ -102,34 +175,88 @@ namespace paramkit {
             return ss.str();
         }
 
+        //! Sets the information about the parameter
+        /**
+        \param basic_info : basic description of the parameter
+        \param extended_info : additional description of the parameter
+        */
+        void setInfo(const std::string& basic_info, const std::string& extended_info = "")
+        {
+            m_info = basic_info;
+            m_extInfo = extended_info;
+            notifyChanged(ParamListener::CHANGED_INFO);
+        }
+
+        //! Sets the information about the parameter, referencing the given static strings (i.e. literals) without copying them
+        /**
+        \param basic_info : basic description of the parameter: must be valid for the lifetime of the parameter
+        \param extended_info : additional description of the parameter: must be valid for the lifetime of the parameter
+        */
+        void setInfoStatic(const char *basic_info, const char *extended_info = nullptr)
+        {
+            m_info = util::PooledString::fromStatic(basic_info);
+            m_extInfo = util::PooledString::fromStatic(extended_info);
+            notifyChanged(ParamListener::CHANGED_INFO);
+        }
+
         //! Prints the parameter using the given color. Appends the parameter switch to the name.
         void printInColor(int color)
         {
-            print_in_color(color, PARAM_SWITCH1 + this->argStr);
+            ColoredText out;
+            printInColor(color, out);
+            print_colored(out);
+        }
+
+        //! Prints the parameter into the given output, using the given color. Appends the parameter switch to the name.
+        void printInColor(int color, ColoredText &out) const
+        {
+            out.append(color, PARAM_SWITCH1 + this->argStr);
         }
 
     protected:
 
         //! Prints a formatted description of the parameter, including its unique name, type, and the info.
         void printDesc(bool isExtended = true) const
+        {
+            ColoredText out;
+            printDesc(out, isExtended);
+            print_colored(out);
+        }
+
+        //! Prints a formatted description of the parameter into the given output.
+        void printDesc(ColoredText &out, bool isExtended = true) const
         {
             if (requiredArg) {
                 if (typeDescStr.length()) {
-                    std::cout << " <" << typeDescStr << ">";
+                    out.append(" <" + typeDescStr.str() + ">");
                 }
                 else {
-                    std::cout << " <" << type() << ">";
+                    out.append(" <" + type() + ">");
                 }
             }
-            std::cout << "\n\t";
-            std::cout << " : " << info(isExtended);
-            std::cout << "\n";
+            out.append("\n\t");
+            out.append(" : " + info(isExtended));
+            out.append("\n");
+        }
+
+        //! Notifies the listener (if any) about the change of the parameter
+        void notifyChanged(ParamListener::t_param_change change)
+        {
+            if (listener) {
+                listener->onParamChanged(this, change);
+            }
         }
 
         //! Checks if the param name is similar to the given filter
-        virtual bool isNameSimilar(const std::string &filter)
+        bool isNameSimilar(const std::string &filter)
         {
-            util::stringsim_type sim_type = util::is_string_similar(argStr, filter);
+            return isNameSimilar(filter, util::CharsetSignature(filter.c_str()));
+        }
+
+        //! Checks if the param name is similar to the given filter, using the set of characters of the filter that was calculated once per query
+        virtual bool isNameSimilar(const std::string &filter, const util::CharsetSignature &filterCharset)
+        {
+            util::stringsim_type sim_type = util::is_string_similar(argStr, nameCharset, filter, filterCharset);
             return (sim_type != util::SIM_NONE) ? true : false;
         }
 
@@ -142,34 +269,51 @@ namespace paramkit {
             return false;
         }
 
-        //! Checks if the description contains the keyword
+        //! Checks if the description contains the keyword. The parameters added to Params are searched by its shared index instead: this check is used only for the standalone groups.
         virtual bool isKeywordInDescription(const std::string &keyword)
         {
-            if (util::has_keyword(m_info, keyword)) return true;
+            util::KeywordIndex index;
+            indexKeywords(index, 0);
+            index.build();
+            std::set<size_t> found;
+            return index.findTexts(keyword, found) != 0;
+        }
 
-            util::stringsim_type sim_type = util::has_keyword(m_extInfo, keyword);
-            return (sim_type != util::SIM_NONE) ? true : false;
+        //! Adds all the texts describing the parameter into the index of the words, as the text with the given id
+        virtual void indexKeywords(util::KeywordIndex &index, size_t textId) const
+        {
+            index.addText(m_info.c_str(), m_info.length(), textId);
+            index.addText(m_extInfo.c_str(), m_extInfo.length(), textId);
         }
 
         //! Extended information
         virtual std::string extendedInfo() const
         {
-            return m_extInfo;
+            return m_extInfo.str();
         }
 
         std::string argStr; ///< a unique name of the parameter
+        util::CharsetSignature nameCharset; ///< the set of characters of the name: calculated once, used to check the similarity
 
-        std::string typeDescStr; ///< a description of the type of the parameter: what type of values are allowed
-        std::string m_info; ///< a basic information about the the parameter's purpose
-        std::string m_extInfo; ///< an extended information about the the parameter's purpose
+        util::PooledString typeDescStr; ///< a description of the type of the parameter: what type of values are allowed
+        util::PooledString m_info; ///< a basic information about the the parameter's purpose
+        util::PooledString m_extInfo; ///< an extended information about the the parameter's purpose
 
         bool isRequired; ///< a flag indicating if this parameter is required
         bool requiredArg; ///< a flag indicating if this parameter needs to be followed by a value
         bool active; ///< a flag indicating if this parameter is available
+        ParamListener *listener; ///< the object notified about the changes (i.e. the container of the parameter)
+
+        bool countedSet; ///< the state of isSet() at the last update of the ParamCounters
+        bool countedActive; ///< the state of isActive() at the last update of the ParamCounters
+        size_t denseId; ///< the index of the parameter in its container, assigned in the order of adding
+        bool inArena; ///< set if the parameter was created by Params::emplaceParam: then it is destroyed along with the arena, instead of being deleted
 
         friend class Params;
         friend class ParamCompare;
         friend class ParamGroup;
+        friend class ParamFilter;
+        friend class ParamCounters;
     };
 
     //! A comparator class for Param class
@@ -190,9 +334,9 @@ namespace paramkit {
         
         typedef enum
         {
-            INT_BASE_ANY = 0,
-            INT_BASE_DEC = 1,
-            INT_BASE_HEX = 2,
+            INT_BASE_ANY = NUM_BASE_ANY,
+            INT_BASE_DEC = NUM_BASE_DEC,
+            INT_BASE_HEX = NUM_BASE_HEX,
             INT_BASE_COUNT
         } t_int_base;
 
@@ -234,42 +378,63 @@ namespace paramkit {
 
         virtual bool parse(const char *arg)
         {
-            if (!arg) return false;
-            const size_t len = strlen(arg);
+            return parseNumber(arg);
+        }
 
-            if (!isValidNumber(arg, len)) {
-                return false;
-            }
-            bool isHex = (base == INT_BASE_HEX);
-            if (base == INT_BASE_ANY) {
-                if (paramkit::is_hex_with_prefix(arg)) {
-                    isHex = true;
-                }
-            }
-            this->value = loadInt(arg, isHex);
-            return true;
+        virtual bool parse(const wchar_t *arg)
+        {
+            return parseNumber(arg);
+        }
+
+        virtual bool parseValue(const char *arg, ParsedValue &out) const
+        {
+            return parseNumberValue(arg, out);
+        }
+
+        virtual bool parseValue(const wchar_t *arg, ParsedValue &out) const
+        {
+            return parseNumberValue(arg, out);
         }
 
+        //! Checks if the string of the given length is a valid value of the parameter
         bool isValidNumber(const char *arg, const size_t len)
         {
-            if (base == INT_BASE_ANY) {
-                if (paramkit::is_hex_with_prefix(arg) || paramkit::is_dec(arg, len)) {
-                    return true;
-                }
-            }
-            if (base == INT_BASE_HEX) {
-                if (paramkit::is_hex(arg, len) || paramkit::is_hex_with_prefix(arg)) {
-                    return true;
-                }
-            }
-            if (base == INT_BASE_DEC) {
-                if (paramkit::is_dec(arg, len)) return true;
-            }
-            return false;
+            uint64_t val = 0;
+            return load_number(arg, len, val, (t_num_base)base) && !isReserved(val);
         }
 
         t_int_base base;
         uint64_t value;
+
+    protected:
+        //! The value equal to PARAM_UNINITIALIZED is reserved: it marks the parameter that is not set, so it can't be accepted as the input
+        static bool isReserved(uint64_t number)
+        {
+            return number == (uint64_t)PARAM_UNINITIALIZED;
+        }
+
+        template <typename T_CHAR>
+        bool parseNumber(const T_CHAR *arg)
+        {
+            uint64_t number = 0;
+            if (!load_number(arg, number, (t_num_base)base) || isReserved(number)) {
+                return false;
+            }
+            this->value = number;
+            return true;
+        }
+
+        template <typename T_CHAR>
+        bool parseNumberValue(const T_CHAR *arg, ParsedValue &out) const
+        {
+            uint64_t number = 0;
+            if (!load_number(arg, number, (t_num_base)base) || isReserved(number)) {
+                return false;
+            }
+            out.number = number;
+            out.isSet = true;
+            return true;
+        }
     };
 
     //! A parameter storing a string value
@@ -304,6 +469,15 @@ namespace paramkit {
             return true;
         }
 
+        virtual bool parseValue(const char *arg, ParsedValue &out) const
+        {
+            if (!arg) return false;
+
+            out.str = arg;
+            out.isSet = !out.str.empty();
+            return true;
+        }
+
         //! Copy the stored string value into an external buffer of a given length
         size_t copyToCStr(char *buf, size_t buf_max) const
         {
@@ -351,10 +525,25 @@ namespace paramkit {
         {
             if (!arg) return false;
 
-            std::string value = arg;
-            std::wstring str(value.begin(), value.end());
+            this->value.assign(arg, arg + strlen(arg));
+            return true;
+        }
 
-            this->value = str;
+        virtual bool parseValue(const wchar_t *arg, ParsedValue &out) const
+        {
+            if (!arg) return false;
+
+            out.wstr = arg;
+            out.isSet = !out.wstr.empty();
+            return true;
+        }
+
+        virtual bool parseValue(const char *arg, ParsedValue &out) const
+        {
+            if (!arg) return false;
+
+            out.wstr.assign(arg, arg + strlen(arg));
+            out.isSet = !out.wstr.empty();
             return true;
         }
 
@@ -402,6 +591,31 @@ namespace paramkit {
         }
 
         virtual bool parse(const char *arg = nullptr)
+        {
+            return parseBoolean(arg);
+        }
+
+        virtual bool parse(const wchar_t *arg)
+        {
+            return parseBoolean(arg);
+        }
+
+        virtual bool parseValue(const char *arg, ParsedValue &out) const
+        {
+            return parseBooleanValue(arg, out);
+        }
+
+        virtual bool parseValue(const wchar_t *arg, ParsedValue &out) const
+        {
+            return parseBooleanValue(arg, out);
+        }
+
+        bool value;
+        bool isParsed;
+
+    protected:
+        template <typename T_CHAR>
+        bool parseBoolean(const T_CHAR *arg)
         {
             if (!arg) {
                 this->value = true;
@@ -412,16 +626,39 @@ namespace paramkit {
             return this->isParsed;
         }
 
-        bool value;
-        bool isParsed;
+        template <typename T_CHAR>
+        bool parseBooleanValue(const T_CHAR *arg, ParsedValue &out) const
+        {
+            bool boolVal = true;
+            if (arg && !loadBoolean(arg, boolVal)) {
+                out.isSet = false;
+                return false;
+            }
+            out.number = boolVal ? 1 : 0;
+            out.isSet = true;
+            return true;
+        }
+    };
+
+
+    //! The definition of a single enum value, used to fill the EnumParam at once: see EnumParam::addEnumValues, and ENUM_VALUE_DEF
+    struct EnumValueDef {
+        int value;
+        const char *str; ///< optional: the string representation (may be nullptr)
+        const char *info;
     };
 
+    //! Defines the enum value, with its name used as the string representation. The scope (i.e. "t_fruits::") is stripped from the name, when the value is added.
+#define ENUM_VALUE_DEF(val, info) { (int)(val), GETNAME(val), info }
 
     //! A parameter storing an enum value
+    /**
+    The values are kept in the flat tables, sorted by the value, and by the string representation, so both of them are found with a binary search.
+    */
     class EnumParam : public Param {
     public:
         EnumParam(const std::string& _argStr, const std::string _enumName, bool _isRequired)
-            : Param(_argStr, _isRequired), enumName(_enumName), m_isSet(false)
+            : Param(_argStr, _isRequired), enumName(_enumName), m_isSet(false), caseSensitive(true)
         {
             requiredArg = true;
             value = PARAM_UNINITIALIZED;
@@ -429,26 +666,95 @@ namespace paramkit {
 
         bool addEnumValue(int value, const std::string &info)
         {
-            enumToInfo[value] = info;
+            std::vector<EnumEntry>::iterator found = findEntry(value);
+            const bool isReplaced = (found != entries.end() && found->value == value);
+            if (isReplaced) {
+                found->info = info;
+            }
+            else {
+                EnumEntry entry;
+                entry.value = value;
+                entry.hasString = false;
+                entry.info = info;
+                entries.insert(found, entry);
+                onEnumValueAdded(value);
+            }
+            notifyChanged(ParamListener::CHANGED_INFO);
             return true;
         }
 
         bool addEnumValue(int value, const std::string &str_val, const std::string &info)
         {
             if (addEnumValue(value, info)) {
-                enumToString[value] = str_val;
+                setEnumString(value, str_val);
             }
             return true;
         }
 
+        //! Adds all the values from the table of the definitions. The scope (i.e. "t_fruits::") is stripped from the string representations, along with the optional prefix.
+        /**
+        The definitions are appended at once, and the tables are sorted once, so adding the big enums doesn't shift the tables for each value.
+        The result is the same as of adding the values one by one: the later definitions of the same value replace the earlier ones.
+        \param defs : the table of the definitions, i.e. filled with ENUM_VALUE_DEF
+        \param count : the number of the definitions
+        \param prefixToStrip : optional: the common prefix of the names, that should be skipped in the string representations (i.e. "FRUIT_")
+        \return the number of the added values
+        */
+        size_t addEnumValues(const EnumValueDef *defs, size_t count, const std::string &prefixToStrip = "")
+        {
+            if (!defs || !count) return 0;
+
+            const size_t prevCount = entries.size();
+            std::vector<int> addedValues;
+            entries.reserve(prevCount + count);
+            for (size_t i = 0; i < count; i++) {
+                EnumEntry entry;
+                entry.value = defs[i].value;
+                entry.info = defs[i].info ? defs[i].info : "";
+                entry.hasString = (defs[i].str != nullptr);
+                if (entry.hasString) {
+                    entry.str = stripName(defs[i].str, prefixToStrip);
+                }
+                // the previous entries are still sorted:
+                std::vector<EnumEntry>::const_iterator found = std::lower_bound(entries.begin(), entries.begin() + prevCount, entry, EnumEntryCompare());
+                if (found == entries.begin() + prevCount || found->value != entry.value) {
+                    addedValues.push_back(entry.value);
+                }
+                entries.push_back(entry);
+            }
+            mergeEntries();
+            std::sort(addedValues.begin(), addedValues.end());
+            addedValues.erase(std::unique(addedValues.begin(), addedValues.end()), addedValues.end());
+            for (std::vector<int>::const_iterator itr = addedValues.begin(); itr != addedValues.end(); ++itr) {
+                onEnumValueAdded(*itr);
+            }
+            notifyChanged(ParamListener::CHANGED_INFO);
+            return count;
+        }
+
+        template <size_t COUNT>
+        size_t addEnumValues(const EnumValueDef (&defs)[COUNT], const std::string &prefixToStrip = "")
+        {
+            return addEnumValues(defs, COUNT, prefixToStrip);
+        }
+
+        //! Sets if the string representations are matched case sensitive (the default), or case insensitive
+        void setCaseSensitive(bool _caseSensitive)
+        {
+            if (caseSensitive == _caseSensitive) return;
+
+            caseSensitive = _caseSensitive;
+            std::sort(stringToEnum.begin(), stringToEnum.end(), EnumStringCompare(caseSensitive));
+        }
+
         virtual std::string valToString() const
         {
             if (!isSet()) {
                 return "(undefined)";
             }
-            std::map<int, std::string>::const_iterator foundString = enumToString.find(value);
-            if (foundString != enumToString.end()) {
-                return foundString->second;
+            std::vector<EnumEntry>::const_iterator found = findEntry(value);
+            if (found->hasString) {
+                return found->str;
             }
             std::stringstream stream;
             stream << std::dec << value;
@@ -477,45 +783,21 @@ namespace paramkit {
             return false;
         }
 
-        bool isKeywordInDescription(const std::string &keyword)
+        //! Adds all the texts describing the parameter into the index of the words: including the type, and the descriptions of particular options
+        virtual void indexKeywords(util::KeywordIndex &index, size_t textId) const
         {
-            if (Param::isKeywordInDescription(keyword)) {
-                return true;
-            }
-            if (isKeywordInType(keyword)) {
-                return true;
-            }
-            // search the keyword also in the descriptions of particulat options:
-            std::map<int, std::string>::const_iterator itr;
-            for (itr = enumToInfo.begin(); itr != enumToInfo.end(); ++itr) {
-                const std::string valDesc = itr->second;
-                util::stringsim_type sim_type = util::has_keyword(valDesc, keyword);
-                if (sim_type != util::SIM_NONE) return true;
+            Param::indexKeywords(index, textId);
+            index.addText(enumName, textId);
+            std::vector<EnumEntry>::const_iterator itr;
+            for (itr = entries.begin(); itr != entries.end(); ++itr) {
+                index.addText(itr->info, textId);
             }
-            return false;
         }
 
         virtual bool parse(const char *arg)
         {
-            if (!arg) return false;
-
-            //try to find by the string representation first:
-            const std::string strVal = arg;
-            std::map<int, std::string>::iterator itr;
-            for (itr = enumToString.begin(); itr != enumToString.end(); ++itr) {
-                if (strVal == itr->second) {
-                    this->value = itr->first;
-                    m_isSet = true;
-                    return true;
-                }
-            }
-            //try to find by the integer representation:
-            if (!is_number(arg)) {
-                return false;
-            }
-            int intVal = loadInt(arg);
-            if (!isInEnumScope(intVal)) {
-                // out of the enum scope
+            int intVal = 0;
+            if (!findEnumValue(arg, intVal)) {
                 return false;
             }
             this->value = intVal;
@@ -523,9 +805,134 @@ namespace paramkit {
             return true;
         }
 
+        virtual bool parseValue(const char *arg, ParsedValue &out) const
+        {
+            int intVal = 0;
+            if (!findEnumValue(arg, intVal)) {
+                return false;
+            }
+            out.number = (uint64_t)intVal;
+            out.isSet = true;
+            return true;
+        }
+
         int value;
 
     protected:
+        //! Called when a new value was added into the table
+        virtual void onEnumValueAdded(int /*value*/)
+        {
+        }
+
+        //! A single value of the enum, along with its descriptions
+        struct EnumEntry {
+            int value;
+            bool hasString;
+            std::string str; ///< optional: string representation of the value
+            std::string info; ///< required: info about the value
+        };
+
+        //! Orders the entries by the value
+        struct EnumEntryCompare {
+            bool operator()(const EnumEntry &a, const EnumEntry &b) const
+            {
+                return a.value < b.value;
+            }
+        };
+
+        //! Returns the name without the scope (i.e. "t_fruits::"), and without the given prefix
+        static std::string stripName(const std::string &name, const std::string &prefixToStrip)
+        {
+            std::string str = name;
+            const size_t scopeEnd = str.rfind("::");
+            if (scopeEnd != std::string::npos) {
+                str = str.substr(scopeEnd + 2);
+            }
+            if (prefixToStrip.length() && str.length() > prefixToStrip.length() && str.compare(0, prefixToStrip.length(), prefixToStrip) == 0) {
+                str = str.substr(prefixToStrip.length());
+            }
+            return str;
+        }
+
+        //! Sorts the appended entries into the table, merging the ones with the same value (the later ones replace the earlier), and rebuilds the index of the strings
+        void mergeEntries()
+        {
+            // the stable sort keeps the entries with the same value in the order of adding:
+            std::stable_sort(entries.begin(), entries.end(), EnumEntryCompare());
+            size_t outPos = 0;
+            for (size_t i = 0; i < entries.size(); i++) {
+                if (outPos && entries[outPos - 1].value == entries[i].value) {
+                    EnumEntry &merged = entries[outPos - 1];
+                    merged.info.swap(entries[i].info);
+                    if (entries[i].hasString) {
+                        merged.hasString = true;
+                        merged.str.swap(entries[i].str);
+                    }
+                    continue;
+                }
+                if (outPos != i) {
+                    std::swap(entries[outPos], entries[i]);
+                }
+                outPos++;
+            }
+            entries.resize(outPos);
+
+            stringToEnum.clear();
+            std::vector<EnumEntry>::const_iterator itr;
+            for (itr = entries.begin(); itr != entries.end(); ++itr) {
+                if (!itr->hasString) continue;
+                EnumString enumStr;
+                enumStr.str = itr->str;
+                enumStr.value = itr->value;
+                stringToEnum.push_back(enumStr);
+            }
+            std::sort(stringToEnum.begin(), stringToEnum.end(), EnumStringCompare(caseSensitive));
+        }
+
+        //! The string representation, pointing to the value
+        struct EnumString {
+            std::string str;
+            int value;
+        };
+
+        //! Orders the string representations by the string (then by the value), or compares them with the searched string
+        struct EnumStringCompare {
+            EnumStringCompare(bool _caseSensitive)
+                : caseSensitive(_caseSensitive)
+            {
+            }
+
+            bool operator()(const EnumString &a, const EnumString &b) const
+            {
+                const int res = util::tstr_compare(a.str, b.str.c_str(), !caseSensitive);
+                if (res != 0) return res < 0;
+                return a.value < b.value;
+            }
+
+            bool operator()(const EnumString &a, const util::StringView &b) const
+            {
+                return compare(a.str, b, caseSensitive) < 0;
+            }
+
+            //! Compares the string representation with the searched string, that may not be NUL-terminated
+            static int compare(const std::string &a, const util::StringView &b, bool caseSensitive)
+            {
+                const size_t len = (a.length() < b.length()) ? a.length() : b.length();
+                for (size_t i = 0; i < len; i++) {
+                    unsigned char c1 = (unsigned char)a[i];
+                    unsigned char c2 = (unsigned char)b[i];
+                    if (!caseSensitive) {
+                        if (c1 >= 'A' && c1 <= 'Z') c1 += ('a' - 'A');
+                        if (c2 >= 'A' && c2 <= 'Z') c2 += ('a' - 'A');
+                    }
+                    if (c1 != c2) return (c1 < c2) ? (-1) : 1;
+                }
+                if (a.length() == b.length()) return 0;
+                return (a.length() < b.length()) ? (-1) : 1;
+            }
+
+            const bool caseSensitive;
+        };
 
         std::string extendedInfo() const
         {
@@ -535,56 +942,332 @@ namespace paramkit {
             return stream.str();
         }
 
-        std::string optionsInfo() const
+        virtual std::string optionsInfo() const
         {
             std::stringstream stream;
-            std::map<int, std::string>::const_iterator itr;
+            std::vector<EnumEntry>::const_iterator itr;
             stream << type() << ":\n";
-            for (itr = enumToInfo.begin(); itr != enumToInfo.end(); ) {
-                int val = itr->first;
-                std::map<int, std::string>::const_iterator foundString = enumToString.find(itr->first);
-
-                stream << "\t" << std::dec << val;
-                if (foundString != enumToString.end()) {
-                    stream << " (" << foundString->second << ")";
+            for (itr = entries.begin(); itr != entries.end(); ) {
+                stream << "\t" << std::dec << itr->value;
+                if (itr->hasString) {
+                    stream << " (" << itr->str << ")";
                 }
                 stream << " - ";
-                stream << itr->second;
+                stream << itr->info;
                 ++itr;
-                if (itr != enumToInfo.end()) {
+                if (itr != entries.end()) {
                     stream << "\n";
                 }
             }
             return stream.str();
         }
 
+        //! Sets the string representation of the value that is already added
+        /**
+        The index of the strings is kept sorted, so each call shifts its tail: to add many values, use addEnumValues, that sorts the index once.
+        */
+        void setEnumString(int value, const std::string &str_val)
+        {
+            std::vector<EnumEntry>::iterator found = findEntry(value);
+            if (found == entries.end() || found->value != value) return;
+
+            const EnumStringCompare compare(caseSensitive);
+            if (found->hasString) {
+                // remove the previous string representation from the index:
+                EnumString prevStr;
+                prevStr.str = found->str;
+                prevStr.value = value;
+                std::vector<EnumString>::iterator itr = std::lower_bound(stringToEnum.begin(), stringToEnum.end(), prevStr, compare);
+                if (itr != stringToEnum.end() && itr->value == value && itr->str == prevStr.str) {
+                    stringToEnum.erase(itr);
+                }
+            }
+            found->hasString = true;
+            found->str = str_val;
+
+            EnumString enumStr;
+            enumStr.str = str_val;
+            enumStr.value = value;
+            stringToEnum.insert(std::upper_bound(stringToEnum.begin(), stringToEnum.end(), enumStr, compare), enumStr);
+        }
+
+        //! Returns the entry with the given value, or the position where it should be inserted
+        std::vector<EnumEntry>::iterator findEntry(int intVal)
+        {
+            std::vector<EnumEntry>::iterator itr = entries.begin();
+            size_t len = entries.size();
+            while (len > 0) {
+                const size_t half = len / 2;
+                if ((itr + half)->value < intVal) {
+                    itr += half + 1;
+                    len -= half + 1;
+                }
+                else {
+                    len = half;
+                }
+            }
+            return itr;
+        }
+
+        std::vector<EnumEntry>::const_iterator findEntry(int intVal) const
+        {
+            return const_cast<EnumParam*>(this)->findEntry(intVal);
+        }
+
+        //! Finds the enum value by its string representation, given as a string of the given length (that doesn't need to be NUL-terminated)
+        bool findEnumString(const char *str, size_t len, int &intVal) const
+        {
+            const util::StringView key(str, len);
+            std::vector<EnumString>::const_iterator found = std::lower_bound(stringToEnum.begin(), stringToEnum.end(), key, EnumStringCompare(caseSensitive));
+            if (found != stringToEnum.end() && EnumStringCompare::compare(found->str, key, caseSensitive) == 0) {
+                intVal = found->value;
+                return true;
+            }
+            return false;
+        }
+
+        //! Finds the enum value given by its string representation, or by its number
+        bool findEnumValue(const char *arg, int &intVal) const
+        {
+            if (!arg) return false;
+
+            //try to find by the string representation first:
+            if (findEnumString(arg, strlen(arg), intVal)) {
+                return true;
+            }
+            //try to find by the integer representation:
+            uint64_t number = 0;
+            if (!load_number(arg, number) || number > INT_MAX) {
+                return false;
+            }
+            if (!isInEnumScope((int)number)) {
+                // out of the enum scope
+                return false;
+            }
+            intVal = (int)number;
+            return true;
+        }
+
         bool isInEnumScope(int intVal)const 
         {
-            if (enumToInfo.find(intVal) != enumToInfo.end()) {
+            std::vector<EnumEntry>::const_iterator found = findEntry(intVal);
+            if (found != entries.end() && found->value == intVal) {
                 return true;
             }
             return false;
         }
 
-        std::map<int, std::string> enumToString; ///< optional: string representation of the enum parameter
-        std::map<int, std::string> enumToInfo; ///< required: info about the enum parameter
+        std::vector<EnumEntry> entries; ///< the values of the enum, sorted by the value
+        std::vector<EnumString> stringToEnum; ///< the string representations of the values, sorted for the binary search
 
         std::string enumName;
         bool m_isSet;
+        bool caseSensitive;
     };
 
 
+    //! A parameter storing a set of the flags, as a bitmask. The flags are defined as the enum values, where each value is the index of the bit (0-63).
+    /**
+    The flags are given as a delimited list of their string representations, i.e. "A|O|S", or as a number: the mask of the bits.
+    */
+    class FlagsParam : public EnumParam {
+    public:
+        //! A constructor of the parameter
+        /**
+        \param _argStr : the name of the parameter
+        \param _enumName : the name of the type of the flags
+        \param _isRequired : the flag if this is a required parameter
+        \param _delimiter : the separator of the flags in the list. NUL is not accepted: then the default ('|') is used.
+        */
+        FlagsParam(const std::string& _argStr, const std::string _enumName, bool _isRequired, char _delimiter = '|')
+            : EnumParam(_argStr, _enumName, _isRequired),
+            delimiter(_delimiter ? _delimiter : '|'), flags(0), validMask(0)
+        {
+        }
+
+        //! Returns the mask of the flag with the given index
+        static uint64_t flagMask(int bitIndex)
+        {
+            if (bitIndex < 0 || bitIndex >= FLAGS_MAX) return 0;
+            return (uint64_t)1 << bitIndex;
+        }
+
+        //! Adds the flag: the bit with the given index (0-63), along with its string representation and info
+        bool addFlag(int bitIndex, const std::string &str_val, const std::string &info)
+        {
+            if (!flagMask(bitIndex)) return false;
+            return addEnumValue(bitIndex, str_val, info);
+        }
+
+        virtual std::string type() const
+        {
+            return "*" + enumName + ": flags, separated by \'" + std::string(1, delimiter) + "\'";
+        }
+
+        virtual bool isSet() const
+        {
+            return m_isSet;
+        }
+
+        virtual std::string valToString() const
+        {
+            if (!isSet()) {
+                return "(undefined)";
+            }
+            std::stringstream stream;
+            uint64_t remaining = flags;
+            std::vector<EnumEntry>::const_iterator itr;
+            for (itr = entries.begin(); itr != entries.end(); ++itr) {
+                const uint64_t mask = flagMask(itr->value);
+                if (!(flags & mask) || !itr->hasString) continue;
+
+                if (remaining != flags) stream << delimiter;
+                stream << itr->str;
+                remaining &= ~mask;
+            }
+            // the flags that have no string representation are given as a number:
+            if (remaining || !flags) {
+                if (remaining != flags) stream << delimiter;
+                stream << "0x" << std::hex << remaining;
+            }
+            return stream.str();
+        }
+
+        virtual bool parse(const char *arg)
+        {
+            uint64_t parsed = 0;
+            if (!parseFlags(arg, parsed)) {
+                return false;
+            }
+            this->flags = parsed;
+            m_isSet = true;
+            return true;
+        }
+
+        virtual bool parseValue(const char *arg, ParsedValue &out) const
+        {
+            uint64_t parsed = 0;
+            if (!parseFlags(arg, parsed)) {
+                return false;
+            }
+            out.number = parsed;
+            out.isSet = true;
+            return true;
+        }
+
+        //! Checks if all the flags from the mask are set
+        bool hasFlags(uint64_t mask) const
+        {
+            return (flags & mask) == mask;
+        }
+
+        //! Checks if the flag with the given index is set
+        bool hasFlag(int bitIndex) const
+        {
+            return (flags & flagMask(bitIndex)) != 0;
+        }
+
+        //! Returns the mask of all the defined flags
+        uint64_t validFlags() const
+        {
+            return validMask;
+        }
+
+        //! Parses the list of the flags into the bitmask, in a single pass. Returns false if any of the elements is not a valid flag, or the list is empty.
+        bool parseFlags(const char *arg, uint64_t &outFlags) const
+        {
+            if (!arg) return false;
+
+            const uint64_t allowed = validMask;
+            uint64_t parsed = 0;
+            bool isFilled = false;
+            const char *pos = arg;
+            while (true) {
+                const char *end = strchr(pos, delimiter);
+                size_t len = end ? (size_t)(end - pos) : strlen(pos);
+                // trim the whitespaces:
+                while (len && isspace((unsigned char)pos[0])) {
+                    pos++;
+                    len--;
+                }
+                while (len && isspace((unsigned char)pos[len - 1])) {
+                    len--;
+                }
+                if (len) {
+                    int bitIndex = 0;
+                    uint64_t mask = 0;
+                    if (findEnumString(pos, len, bitIndex)) {
+                        mask = flagMask(bitIndex);
+                        if (!mask) return false;
+                    }
+                    else if (!load_number(pos, len, mask) || (mask & ~allowed)) {
+                        return false;
+                    }
+                    parsed |= mask;
+                    isFilled = true;
+                }
+                if (!end) break;
+                pos = end + 1;
+            }
+            if (!isFilled) return false;
+
+            outFlags = parsed;
+            return true;
+        }
+
+        const char delimiter;
+        uint64_t flags; ///< the bitmask of the set flags
+
+    protected:
+        static const int FLAGS_MAX = 64;
+
+        //! Updates the mask of the defined flags, so that it is not recalculated on each parsing
+        virtual void onEnumValueAdded(int value)
+        {
+            validMask |= flagMask(value);
+        }
+
+        uint64_t validMask; ///< the mask of all the defined flags
+
+        virtual std::string optionsInfo() const
+        {
+            std::stringstream stream;
+            std::vector<EnumEntry>::const_iterator itr;
+            stream << type() << ":\n";
+            for (itr = entries.begin(); itr != entries.end(); ) {
+                stream << "\t0x" << std::hex << flagMask(itr->value);
+                if (itr->hasString) {
+                    stream << " (" << itr->str << ")";
+                }
+                stream << " - ";
+                stream << itr->info;
+                ++itr;
+                if (itr != entries.end()) {
+                    stream << "\n";
+                }
+            }
+            return stream.str();
+        }
+    };
+
+
+    //! A parameter storing a list of the strings, separated by the delimiter
+    /**
+    The elements can be accessed as the views into the stored value: the list is split once, when the elements are requested, and the result is cached. The elements are kept in the order of the input, with the whitespaces trimmed, and the empty ones skipped.
+    */
     class StringListParam : public StringParam {
     public:
         StringListParam(const std::string& _argStr, bool _isRequired, char _delimiter)
             : StringParam(_argStr, _isRequired),
-            delimiter(std::string(1, _delimiter))
+            delimiter(std::string(1, _delimiter)),
+            uniqueElements(false), elementsValid(false)
         {
         }
 
         StringListParam(const std::string& _argStr, bool _isRequired, std::string _delimiter)
             : StringParam(_argStr, _isRequired),
-            delimiter(_delimiter)
+            delimiter(_delimiter),
+            uniqueElements(false), elementsValid(false)
         {
         }
 
@@ -593,65 +1276,366 @@ namespace paramkit {
             return "list: separated by \'" + delimiter + "\'";
         }
 
+        virtual bool parse(const char *arg)
+        {
+            if (!StringParam::parse(arg)) return false;
+
+            invalidateElements();
+            return true;
+        }
+
+        //! Sets if the duplicated elements should be skipped (the first occurrence is kept)
+        void setUniqueElements(bool _unique)
+        {
+            uniqueElements = _unique;
+            invalidateElements();
+        }
+
+        //! Returns the elements of the list, as the views into the copy of the value. The value is split at the first call, and then the cached result is returned.
+        /**
+        The value is public, so it may be modified without the notification: it is compared with the copy from which the elements were split, and split again if it has changed.
+        The views are valid until the next call after the value was modified.
+        */
+        util::Span<util::StringView> getElements()
+        {
+            if (!elementsValid || splitValue != value) {
+                splitElements();
+            }
+            return util::Span<util::StringView>(elements);
+        }
+
+        //! Fills the set with the copies of the elements (sorted, and without the duplicates). Kept for the compatibility: prefer getElements().
         size_t stripToElements(OUT std::set<std::string> &elements_list)
         {
-            return strip_to_list(this->value, this->delimiter, elements_list);
+            util::Span<util::StringView> views = getElements();
+            for (util::Span<util::StringView>::const_iterator itr = views.begin(); itr != views.end(); ++itr) {
+                elements_list.insert(itr->str());
+            }
+            return elements_list.size();
         }
 
         const std::string delimiter;
+
+    protected:
+        void invalidateElements()
+        {
+            elementsValid = false;
+        }
+
+        static bool isTrimmed(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        }
+
+        static void trimElement(const char *&str, size_t &len)
+        {
+            while (len && isTrimmed(str[0])) {
+                str++;
+                len--;
+            }
+            while (len && isTrimmed(str[len - 1])) {
+                len--;
+            }
+        }
+
+        //! Appends the element with the whitespaces trimmed, unless it is empty
+        void addElement(const char *str, size_t len)
+        {
+            trimElement(str, len);
+            if (len) {
+                elements.push_back(util::StringView(str, len));
+            }
+        }
+
+        //! Compares the elements by their content, and then by their position, so that the first occurrence goes first
+        struct ElementIdCompare {
+            ElementIdCompare(const std::vector<util::StringView> &_elements)
+                : elements(_elements)
+            {
+            }
+
+            bool operator()(size_t id1, size_t id2) const
+            {
+                const int res = elements[id1].compare(elements[id2]);
+                if (res != 0) return res < 0;
+                return id1 < id2;
+            }
+
+            const std::vector<util::StringView> &elements;
+        };
+
+        void removeDuplicates()
+        {
+            std::vector<size_t> ids(elements.size());
+            for (size_t i = 0; i < ids.size(); i++) {
+                ids[i] = i;
+            }
+            std::sort(ids.begin(), ids.end(), ElementIdCompare(elements));
+
+            std::vector<bool> isDuplicate(elements.size(), false);
+            for (size_t i = 1; i < ids.size(); i++) {
+                if (elements[ids[i]] == elements[ids[i - 1]]) {
+                    isDuplicate[ids[i]] = true;
+                }
+            }
+            size_t outPos = 0;
+            for (size_t i = 0; i < elements.size(); i++) {
+                if (isDuplicate[i]) continue;
+                elements[outPos++] = elements[i];
+            }
+            elements.resize(outPos);
+        }
+
+        void splitElements()
+        {
+            elements.clear();
+            splitValue = value;
+            const size_t delimLen = delimiter.length();
+            size_t start = 0;
+            while (start <= splitValue.size()) {
+                const size_t end = delimLen ? splitValue.find(delimiter, start) : std::string::npos;
+                if (end == std::string::npos) {
+                    addElement(splitValue.data() + start, splitValue.size() - start);
+                    break;
+                }
+                addElement(splitValue.data() + start, end - start);
+                start = end + delimLen;
+            }
+            if (uniqueElements) {
+                removeDuplicates();
+            }
+            elementsValid = true;
+        }
+
+        bool uniqueElements;
+        std::string splitValue; ///< the copy of the value from which the cached elements were split
+        std::vector<util::StringView> elements; ///< the cached elements: the views into the splitValue
+        bool elementsValid;
     };
 
+    //! A parameter storing a list of the numbers (decimal, or hexadecimal with the "0x" prefix). Besides of the single numbers, the list may contain the ranges, i.e. "1-5".
+    /**
+    The list is parsed once, when the value is set, into a contiguous vector of the numbers. By default the numbers are kept in the order in which they were given, along with the duplicates.
+    */
     class IntListParam : public StringListParam {
     public:
         IntListParam(const std::string& _argStr, bool _isRequired, char _delimiter)
-            : StringListParam(_argStr, _isRequired, _delimiter)
+            : StringListParam(_argStr, _isRequired, _delimiter),
+            sorted(false), unique(false)
         {
         }
 
         IntListParam(const std::string& _argStr, bool _isRequired, std::string _delimiter)
-            : StringListParam(_argStr, _isRequired, _delimiter)
+            : StringListParam(_argStr, _isRequired, _delimiter),
+            sorted(false), unique(false)
         {
         }
 
         virtual std::string type() const
         {
-            return "list: dec or hex, separated by \'" + delimiter + "\'";
+            std::string str = "list: dec or hex, separated by \'" + delimiter + "\'";
+            if (isRangeAllowed()) {
+                str += ", ranges allowed";
+            }
+            return str;
+        }
+
+        //! Sets how the parsed numbers are ordered. Applies to the values that are parsed after the change.
+        /**
+        \param _sorted : if set, the numbers are sorted in the ascending order; otherwise, they are kept in the order of the input
+        \param _unique : if set, the duplicates are removed (the first occurrence is kept)
+        */
+        void setOrder(bool _sorted, bool _unique)
+        {
+            sorted = _sorted;
+            unique = _unique;
         }
 
         virtual bool parse(const char *arg)
         {
+            std::vector<uint64_t> parsed;
+            if (!parseList(arg, parsed)) return false;
+
+            this->value = arg;
+            this->numbers.swap(parsed);
+            this->membership.build(this->numbers);
+            invalidateElements();
+            return true;
+        }
+
+        virtual bool parseValue(const char *arg, ParsedValue &out) const
+        {
+            if (!parseList(arg, out.numbers)) return false;
+
+            out.str = arg;
+            out.isSet = !out.str.empty();
+            return true;
+        }
+
+        //! Returns the numbers parsed from the list. The view is valid until the next parsing.
+        util::Span<uint64_t> getNumbers() const
+        {
+            return util::Span<uint64_t>(numbers);
+        }
+
+        //! Checks if the number belongs to the list. The lookup takes constant time: the list is frozen into the membership set when it is parsed.
+        /**
+        Note that the set reflects the last parsing: if the value was assigned directly, it must be parsed (i.e. by parse(value.c_str())) to be taken into account.
+        */
+        bool contains(uint64_t number) const
+        {
+            return membership.contains(number);
+        }
+
+        //! Returns the frozen set of the numbers, built from the list
+        const util::MembershipSet& getMembershipSet() const
+        {
+            return membership;
+        }
+
+        //! Checks if all the elements of the list are numbers, or valid ranges
+        bool isValidList(const char *arg) const
+        {
+            std::vector<uint64_t> parsed;
+            return parseList(arg, parsed);
+        }
+
+        //! Parses the list into the vector of the numbers, in a single pass. Returns false if any of the elements is invalid, the list is empty, or it has more than INT_LIST_COUNT_MAX numbers.
+        bool parseList(const char *arg, OUT std::vector<uint64_t> &out) const
+        {
+            out.clear();
             if (!arg) return false;
 
-            std::set<std::string> str_list;
-            if (!strip_to_list(arg, this->delimiter, str_list)) {
-                return false;
-            }
-            std::set<std::string>::iterator itr;
-            for (itr = str_list.begin(); itr != str_list.end(); ++itr) {
-                std::string nextEl = *itr;
-                if (!paramkit::is_number(nextEl.c_str())) return false;
+            const size_t delimLen = delimiter.length();
+            const bool rangeAllowed = isRangeAllowed();
+            const char *pos = arg;
+            while (true) {
+                const char *end = delimLen ? strstr(pos, delimiter.c_str()) : nullptr;
+                const size_t len = end ? (size_t)(end - pos) : strlen(pos);
+                if (!parseElement(pos, len, rangeAllowed, out)) {
+                    out.clear();
+                    return false;
+                }
+                if (!end) break;
+                pos = end + delimLen;
             }
-            this->value = arg;
+            if (out.empty()) return false;
+
+            applyOrder(out);
             return true;
         }
 
-        size_t stripToIntElements(OUT std::set<long> &elements_list)
+        //! Fills the set with the numbers parsed from the current value (sorted, and without the duplicates). The invalid elements are skipped. Kept for the compatibility: prefer getNumbers().
+        /**
+        The value is parsed again, so the value that was assigned directly is also taken into account. The numbers that don't fit in the long are skipped.
+        */
+        size_t stripToIntElements(OUT std::set<long> &elements_list) const
         {
-            std::set<std::string> str_list;
-            if (!stripToElements(str_list)) {
-                return 0;
+            std::set<uint64_t> all;
+            stripToIntElements(all);
+            std::set<uint64_t>::const_iterator itr;
+            for (itr = all.begin(); itr != all.end(); ++itr) {
+                if (*itr > (uint64_t)LONG_MAX) break; // the rest is bigger
+                elements_list.insert((long)*itr);
             }
-            std::set<std::string>::iterator itr;
-            for (itr = str_list.begin(); itr != str_list.end(); ++itr) {
-                std::string nextEl = *itr;
-                if (!paramkit::is_number(nextEl.c_str())) continue;
+            return elements_list.size();
+        }
 
-                long number = paramkit::get_number(nextEl.c_str());
-                elements_list.insert(number);
+        //! Fills the set with the numbers parsed from the current value, in their full range. The invalid elements are skipped.
+        size_t stripToIntElements(OUT std::set<uint64_t> &elements_list) const
+        {
+            const size_t delimLen = delimiter.length();
+            const bool rangeAllowed = isRangeAllowed();
+            std::vector<uint64_t> parsed;
+            const char *pos = value.c_str();
+            while (true) {
+                const char *end = delimLen ? strstr(pos, delimiter.c_str()) : nullptr;
+                const size_t len = end ? (size_t)(end - pos) : strlen(pos);
+                const size_t prevCount = parsed.size();
+                if (!parseElement(pos, len, rangeAllowed, parsed)) {
+                    parsed.resize(prevCount);
+                }
+                if (!end) break;
+                pos = end + delimLen;
             }
+            elements_list.insert(parsed.begin(), parsed.end());
             return elements_list.size();
         }
 
+    protected:
+        //! The ranges are not recognized if the delimiter contains the range separator
+        bool isRangeAllowed() const
+        {
+            return delimiter.find(INT_LIST_RANGE_SEPARATOR) == std::string::npos;
+        }
+
+        //! Parses a single element of the list: a number, or a range, appending it to the numbers parsed so far. An empty element is skipped.
+        static bool parseElement(const char *str, size_t len, bool rangeAllowed, OUT std::vector<uint64_t> &out)
+        {
+            trimElement(str, len);
+            if (!len) return true;
+            if (out.size() >= INT_LIST_COUNT_MAX) return false;
+
+            // the separator of the range can't be the first character:
+            const void *separator = rangeAllowed ? memchr(str + 1, INT_LIST_RANGE_SEPARATOR, len - 1) : nullptr;
+            if (!separator) {
+                uint64_t number = 0;
+                if (!load_number(str, len, number)) return false;
+                out.push_back(number);
+                return true;
+            }
+            const char *first = str;
+            size_t firstLen = static_cast<const char*>(separator) - str;
+            const char *last = static_cast<const char*>(separator) + 1;
+            size_t lastLen = len - firstLen - 1;
+            trimElement(first, firstLen);
+            trimElement(last, lastLen);
+
+            uint64_t start = 0, stop = 0;
+            if (!load_number(first, firstLen, start) || !load_number(last, lastLen, stop)) return false;
+            if (start > stop || (stop - start) >= INT_LIST_RANGE_MAX) return false;
+            if ((stop - start) >= (uint64_t)(INT_LIST_COUNT_MAX - out.size())) return false;
+
+            out.reserve(out.size() + (size_t)(stop - start) + 1);
+            for (uint64_t number = start; ; number++) {
+                out.push_back(number);
+                if (number == stop) break; // checked before incrementing: the range may end at UINT64_MAX
+            }
+            return true;
+        }
+
+        void applyOrder(std::vector<uint64_t> &list) const
+        {
+            if (sorted) {
+                std::sort(list.begin(), list.end());
+                if (unique) {
+                    list.erase(std::unique(list.begin(), list.end()), list.end());
+                }
+                return;
+            }
+            if (!unique) return;
+
+            // keep the first occurrences, in the original order:
+            std::vector<uint64_t> distinct(list);
+            std::sort(distinct.begin(), distinct.end());
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+            if (distinct.size() == list.size()) return;
+
+            std::vector<bool> isTaken(distinct.size(), false);
+            size_t outPos = 0;
+            for (size_t i = 0; i < list.size(); i++) {
+                const size_t id = std::lower_bound(distinct.begin(), distinct.end(), list[i]) - distinct.begin();
+                if (isTaken[id]) continue;
+                isTaken[id] = true;
+                list[outPos++] = list[i];
+            }
+            list.resize(outPos);
+        }
+
+        bool sorted;
+        bool unique;
+        std::vector<uint64_t> numbers; ///< the numbers parsed from the value
+        util::MembershipSet membership; ///< the numbers, frozen for the fast lookups
     };
 };
 
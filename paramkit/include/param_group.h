@@ -5,8 +5,6 @@
 
 #pragma once
 
-#include <windows.h>
-
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -19,6 +17,169 @@
 
 namespace paramkit {
 
+    //! The numbers of the parameters in each category: updated when the parameters are added, removed or changed, so that they don't have to be counted by scanning all the parameters.
+    /**
+    The state of each parameter (set, active) is remembered at the moment it is counted, so it can be uncounted consistently, even if it has changed in the meantime.
+    */
+    class ParamCounters {
+    public:
+        ParamCounters()
+        {
+            clear();
+        }
+
+        void clear()
+        {
+            for (size_t i = 0; i < CATEGORIES_COUNT; i++) {
+                total[i] = 0;
+                filled[i] = 0;
+                active[i] = 0;
+            }
+        }
+
+        //! Remembers the current state of the parameter, so that it will be counted in it
+        static void updateState(Param *param)
+        {
+            param->countedSet = param->isSet();
+            param->countedActive = param->isActive();
+        }
+
+        void add(const Param *param)
+        {
+            const size_t category = categoryOf(param->isRequired);
+            total[category]++;
+            if (param->countedSet) filled[category]++;
+            if (param->countedActive) active[category]++;
+        }
+
+        void remove(const Param *param)
+        {
+            const size_t category = categoryOf(param->isRequired);
+            total[category]--;
+            if (param->countedSet) filled[category]--;
+            if (param->countedActive) active[category]--;
+        }
+
+        //! Returns the number of the parameters of particular category: required or optional
+        size_t countTotal(bool isRequired) const
+        {
+            return total[categoryOf(isRequired)];
+        }
+
+        //! Returns the number of the parameters of particular category that are set
+        size_t countFilled(bool isRequired) const
+        {
+            return filled[categoryOf(isRequired)];
+        }
+
+        //! Returns the number of the parameters of particular category that are active
+        size_t countActive(bool isRequired) const
+        {
+            return active[categoryOf(isRequired)];
+        }
+
+        //! Returns the number of the parameters of particular category that are not set
+        size_t countMissing(bool isRequired) const
+        {
+            return countTotal(isRequired) - countFilled(isRequired);
+        }
+
+    protected:
+        enum {
+            CATEGORY_OPTIONAL = 0,
+            CATEGORY_REQUIRED = 1,
+            CATEGORIES_COUNT
+        };
+
+        static size_t categoryOf(bool isRequired)
+        {
+            return isRequired ? CATEGORY_REQUIRED : CATEGORY_OPTIONAL;
+        }
+
+        size_t total[CATEGORIES_COUNT];
+        size_t filled[CATEGORIES_COUNT];
+        size_t active[CATEGORIES_COUNT];
+    };
+
+    //---
+
+    //! The result of filtering the parameters by the given string: the matching parameters, along with the colors hilighting the kind of the match. It is computed once per query, and shared by all the groups.
+    class ParamFilter {
+    public:
+        ParamFilter(const std::string &_filter = "")
+            : filter(_filter), filterCharset(_filter.c_str())
+        {
+        }
+
+        //! Returns true if no filter is set, so all the parameters should be printed
+        bool isEmpty() const
+        {
+            return filter.empty();
+        }
+
+        //! Adds the parameter to the matching ones, unless it was already added
+        void addMatch(Param *param, int color)
+        {
+            if (!param) return;
+            matches.insert(std::pair<Param*, int>(param, color));
+        }
+
+        //! Checks the parameter against the filter, and adds it if it matches. Used when the parameter was not found via the index.
+        bool checkParam(Param *param)
+        {
+            if (isEmpty() || !param) return false;
+            if (hasMatch(param)) return true;
+
+            if (param->isNameSimilar(filter, filterCharset)) {
+                addMatch(param, PARAM_SIMILAR_NAME);
+                return true;
+            }
+            if (param->isKeywordInDescription(filter)) {
+                addMatch(param, PARAM_SIMILAR_DESC);
+                return true;
+            }
+            return false;
+        }
+
+        //! Checks if the parameter matches the filter. If so, fills the color hilighting the kind of the match.
+        bool hasMatch(Param *param, int &color) const
+        {
+            std::map<Param*, int>::const_iterator itr = matches.find(param);
+            if (itr == matches.end()) {
+                return false;
+            }
+            color = itr->second;
+            return true;
+        }
+
+        bool hasMatch(Param *param) const
+        {
+            int color = 0;
+            return hasMatch(param, color);
+        }
+
+        //! Counts the matching parameters of particular category (required or optional) that belong to the given set
+        size_t countMatches(const std::set<Param*, ParamCompare> &params, bool isRequired) const
+        {
+            size_t count = 0;
+            std::map<Param*, int>::const_iterator itr;
+            for (itr = matches.begin(); itr != matches.end(); ++itr) {
+                Param *param = itr->first;
+                if (param->isRequired != isRequired) continue;
+                if (params.find(param) != params.end()) {
+                    count++;
+                }
+            }
+            return count;
+        }
+
+        const std::string filter;
+        const util::CharsetSignature filterCharset; ///< the set of characters of the filter: calculated once per query
+
+    protected:
+        std::map<Param*, int> matches;
+    };
+
     //---
     //! The class responsible for grouping parameters (objects of the type Param)
     class ParamGroup {
@@ -43,15 +204,37 @@ namespace paramkit {
         \return number of printed parameters
         */
         size_t printGroup(bool printGroupName, bool printRequired, bool hilightMissing, const std::string &filter = "", bool isExtended = false)
+        {
+            ParamFilter paramFilter(filter);
+            std::set<Param*, ParamCompare>::iterator itr;
+            for (itr = params.begin(); itr != params.end(); ++itr) {
+                paramFilter.checkParam(*itr);
+            }
+            ColoredText out;
+            const size_t printed = printGroup(out, printGroupName, printRequired, hilightMissing, paramFilter, isExtended);
+            print_colored(out);
+            return printed;
+        }
+
+        //! Prints the whole group of parameters (their names and descriptions) into the given output, optionally with the group name
+        /**
+        \param out : the output to which the group is printed
+        \param printGroupName : a flag indicating if the group name will be printed
+        \param printRequired : a flag indicating if the required parameters should be printed. If true, only required are printed. If false, only optional are printed.
+        \param hilightMissing : a flag indicating if the required parameters that are not filled should be hiligted.
+        \param filter : the parameters matching the searched string. If not empty, only the matching parameters are printed.
+        \param isExtended : print extended info about each parameter
+        \return number of printed parameters
+        */
+        size_t printGroup(ColoredText &out, bool printGroupName, bool printRequired, bool hilightMissing, const ParamFilter &filter, bool isExtended = false)
         {
             if (countParams(printRequired, hilightMissing, filter) == 0) {
                 return 0;
             }
-            const bool has_filter = filter.length() > 0 ? true : false;
             size_t printed = 0;
 
             if (printGroupName && name.length()) {
-                print_in_color(separatorColor, "\n---" + name + "---\n");
+                out.append(separatorColor, "\n---" + name + "---\n");
             }
             std::set<Param*, ParamCompare>::iterator itr;
             for (itr = params.begin(); itr != params.end(); ++itr) {
@@ -66,54 +249,39 @@ namespace paramkit {
                     color = WARNING_COLOR;
                     should_print = true;
                 }
-                if (has_filter) {
-                    bool has_any = param->isNameSimilar(filter);
-                    color = has_any ? PARAM_SIMILAR_NAME : paramColor;
-                    if (!has_any) {
-                        has_any = param->isKeywordInDescription(filter);
-                        color = has_any ? PARAM_SIMILAR_DESC : paramColor;
-                    }
-                    if (!has_any) continue;
+                if (!filter.isEmpty()) {
+                    if (!filter.hasMatch(param, color)) continue;
                 }
                 if (should_print) {
                     if (!param->isActive()) {
                         color = INACTIVE_COLOR;
                     }
-                    param->printInColor(color);
-                    param->printDesc(isExtended);
+                    param->printInColor(color, out);
+                    param->printDesc(out, isExtended);
                     printed++;
                 }
             }
             return printed;
         }
 
+        //! Returns the counters of the parameters in this group
+        const ParamCounters& getCounters() const
+        {
+            return counters;
+        }
+
     protected:
 
-        size_t countParams(bool printRequired, bool hilightMissing, const std::string &filter)
+        //! Counts the parameters that would be printed with the given options. Uses the counters, so the group is not scanned (unless the filter is set: then only its matches are checked).
+        size_t countParams(bool printRequired, bool hilightMissing, const ParamFilter &filter) const
         {
-            const bool has_filter = filter.length() > 0 ? true : false;
-            size_t printed = 0;
-            std::set<Param*, ParamCompare>::iterator itr;
-            for (itr = params.begin(); itr != params.end(); ++itr) {
-                Param* param = (*itr);
-
-                if (!param) continue;
-                if (printRequired != param->isRequired) continue;
-                bool should_print = hilightMissing ? false : true;
-                if (hilightMissing && param->isRequired && !param->isSet()) {
-                    should_print = true;
-                }
-                if (has_filter) {
-                    should_print = false;
-                    if (param->isNameSimilar(filter) || param->isKeywordInDescription(filter)) {
-                        should_print = true;
-                    }
-                }
-                if (should_print) {
-                    printed++;
-                }
+            if (!filter.isEmpty()) {
+                return filter.countMatches(params, printRequired);
             }
-            return printed;
+            if (hilightMissing) {
+                return printRequired ? counters.countMissing(true) : 0;
+            }
+            return counters.countTotal(printRequired);
         }
 
         bool hasParam(Param *param)
@@ -129,13 +297,15 @@ namespace paramkit {
         {
             if (hasParam(param)) return false;
             this->params.insert(param);
-            return false;
+            counters.add(param);
+            return true;
         }
 
         bool removeParam(Param *param)
         {
             std::set<Param*, ParamCompare>::iterator itr = params.find(param);
             if (itr != params.end()) {
+                counters.remove(*itr);
                 params.erase(itr);
                 return true;
             }
@@ -144,6 +314,7 @@ namespace paramkit {
 
         std::string name;
         std::set<Param*, ParamCompare> params;
+        ParamCounters counters; ///< the numbers of the parameters in the group, by categories
 
         const int hdrColor;
         const int paramColor;
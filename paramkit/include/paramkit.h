@@ -9,6 +9,8 @@
 #include "pk_util.h"
 #include "param.h"
 #include "params.h"
+#include "static_params.h"
 #include "term_colors.h"
+#include "term_sink.h"
 
 #endif
@@ -5,17 +5,25 @@
 
 #pragma once
 
-#include <windows.h>
-
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include "pk_util.h"
 #include "color_scheme.h"
 #include "param.h"
 #include "param_group.h"
+#include "similarity_index.h"
+#include "arena.h"
+#include "work_pool.h"
+#include "cmdline_tokenizer.h"
+#include "args_stream.h"
+#include "config_file.h"
 //--
 
 #define PARAM_HELP1 "?"
@@ -26,18 +34,29 @@
 namespace paramkit {
 
     //! The class responsible for storing and parsing parameters (objects of the type Param), possibly divided into groups (ParamGroup)
-    class Params {
+    class Params : public ParamListener {
     public:
-        Params(const std::string &version = "")
+        static const size_t INVALID_PARAM_ID = (size_t)(-1); ///< returned by getParamId if the parameter does not exist
+
+        //! A constructor of the parameters container
+        /**
+        \param version : the version of the application
+        \param externalArena : an optional arena in which the parameters created by emplaceParam will be allocated. It must outlive this object. If not given, an own arena is used.
+        */
+        Params(const std::string &version = "", util::MonotonicArena *externalArena = nullptr)
             : generalGroup(nullptr), versionStr(version),
+            responseFilesEnabled(false), responseFileStyle(CMDLINE_NATIVE),
+            paramsArena(externalArena ? externalArena : &ownArena),
+            namesIndexed(false), descriptionsIndexed(false),
             paramHelp(PARAM_HELP2, false), paramHelpP(PARAM_HELP2, false), paramInfoP("<param> ?", false),
             paramVersion(PARAM_VERSION, false),
             hdrColor(HEADER_COLOR), paramColor(HILIGHTED_COLOR)
         {
-            paramHelp.m_info = "Print complete help.";
-            paramHelpP.m_info = "Print help about a given keyword.";
-            paramInfoP.m_info = "Print details of a given parameter.";
-            paramVersion.m_info = "Print version info.";
+            paramHelp.m_info = util::PooledString::fromStatic("Print complete help.");
+            paramHelpP.m_info = util::PooledString::fromStatic("Print help about a given keyword.");
+            paramInfoP.m_info = util::PooledString::fromStatic("Print details of a given parameter.");
+            paramVersion.m_info = util::PooledString::fromStatic("Print version info.");
+            invalidateInfo();
         }
 
         virtual ~Params()
@@ -65,6 +84,7 @@ namespace paramkit {
                 return false;
             }
             this->paramGroups[group->name] = group;
+            invalidateInfo();
             return true;
         }
 
@@ -86,13 +106,39 @@ namespace paramkit {
 
         //! Adds a parameter into the storage
         /**
+        If a parameter with the same name was already added, it is replaced: removed from its group, and deleted (unless it was created by emplaceParam). The new parameter takes over its dense index.
         \param param : an object inheriting from the class Param
         */
         void addParam(Param* param)
         {
             if (!param) return;
             const std::string argStr = param->argStr;
+            Param *replaced = getParam(argStr);
+            if (replaced == param) return; // already added
             this->myParams[argStr] = param;
+            this->indexParam(param);
+            if (replaced) {
+                param->denseId = replaced->denseId;
+                releaseReplaced(replaced);
+                paramsById[param->denseId] = param;
+            }
+            else {
+                param->denseId = paramsById.size();
+                paramsById.push_back(param);
+            }
+            param->listener = this;
+            internInfo(param);
+            if (param->isRequired) {
+                requiredIds.insert(std::lower_bound(requiredIds.begin(), requiredIds.end(), param->denseId), param->denseId);
+            }
+            ParamCounters::updateState(param);
+            counters.add(param);
+            updateMissingRequired(param);
+            invalidateInfo();
+            descriptionsIndexed = false;
+            if (namesIndexed) {
+                this->similarNames.insert(argStr);
+            }
             if (!generalGroup) {
                 generalGroup = new ParamGroup("");
                 this->addGroup(generalGroup);
@@ -100,6 +146,21 @@ namespace paramkit {
             this->addParamToGroup(param, this->generalGroup);
         }
 
+        //! Creates a parameter of the type PARAM_T in the arena, and adds it into the storage. The arguments are passed to the constructor of the parameter.
+        /**
+        Allows to build big schemas with fewer allocations: the parameter objects are not allocated separately, but placed in the blocks of the arena.
+        Their names and descriptions, and the nodes of the containers referencing them, are still allocated on the heap.
+        \return the created parameter
+        */
+        template <class PARAM_T, class... Args>
+        PARAM_T* emplaceParam(Args&&... args)
+        {
+            PARAM_T *param = paramsArena->create<PARAM_T>(std::forward<Args>(args)...);
+            param->inArena = true;
+            addParam(param);
+            return param;
+        }
+
         //! Sets the information about the parameter, defined by its name
         /**
         \param paramName : a unique name of the parameter
@@ -112,9 +173,24 @@ namespace paramkit {
             Param *p = getParam(paramName);
             if (!p) return false;
 
-            p->m_info = basic_info;
-            p->m_extInfo = extended_info;
-            return false;
+            p->setInfo(basic_info, extended_info);
+            return true;
+        }
+
+        //! Sets the information about the parameter, defined by its name. The descriptions are referenced directly, without copying.
+        /**
+        \param paramName : a unique name of the parameter
+        \param basic_info : basic description of the parameter: a static string (i.e. a literal)
+        \param extended_info : additional description of the parameter: a static string (i.e. a literal)
+        \return true if setting the info was successful
+        */
+        bool setInfoStatic(const std::string& paramName, const char *basic_info, const char *extended_info = nullptr)
+        {
+            Param *p = getParam(paramName);
+            if (!p) return false;
+
+            p->setInfoStatic(basic_info, extended_info);
+            return true;
         }
 
         //! Prints info about all the parameters. Optionally hilights the required ones that are missing.
@@ -125,12 +201,37 @@ namespace paramkit {
         */
         void printInfo(bool hilightMissing=false, const std::string &filter = "", bool isExtended = true)
         {
-            std::cout << "---" << std::endl;
-            _info(true, hilightMissing, filter, isExtended);
-            _info(false, hilightMissing, filter, isExtended);
-            const bool extendedInfoS = (filter.empty() && !hilightMissing) ? isExtended : false;
-            printInfoSection(extendedInfoS);
-            std::cout << "---" << std::endl;
+            print_colored(renderInfo(hilightMissing, filter, isExtended));
+        }
+
+        //! Renders info about all the parameters (the same that is printed by printInfo) into a colored text.
+        /**
+        The rendered text of all the parameters is cached until the parameters are changed (added, moved between the groups, activated/deactivated, or their descriptions are changed).
+        The filtered output, and the output that hilights the missing parameters (that depends on the values) are never cached: they are valid till the next call.
+        \param hilightMissing : if set, the required parameters that were not filled are hilighted.
+        \param filter : display only parameters similar to the given string
+        \param isExtended : display extended info about each parameter
+        */
+        const ColoredText& renderInfo(bool hilightMissing = false, const std::string &filter = "", bool isExtended = true)
+        {
+            if (hilightMissing || filter.length()) {
+                uncachedInfo.clear();
+                _renderInfo(uncachedInfo, hilightMissing, filter, isExtended);
+                return uncachedInfo;
+            }
+            const size_t cacheId = isExtended ? 1 : 0;
+            if (!isInfoCached[cacheId]) {
+                cachedInfo[cacheId].clear();
+                _renderInfo(cachedInfo[cacheId], hilightMissing, filter, isExtended);
+                isInfoCached[cacheId] = true;
+            }
+            return cachedInfo[cacheId];
+        }
+
+        //! Returns info about all the parameters (the same that is printed by printInfo) as a plain text, without the colors.
+        std::string infoToString(bool hilightMissing = false, const std::string &filter = "", bool isExtended = true)
+        {
+            return renderInfo(hilightMissing, filter, isExtended).str();
         }
 
         //! Prints brief info about all the parameters. Wrapper for printInfo.
@@ -155,6 +256,7 @@ namespace paramkit {
                 return false;
             }
             param->value = val;
+            param->notifyChanged(ParamListener::CHANGED_VALUE);
             return true;
         }
 
@@ -191,22 +293,45 @@ namespace paramkit {
             return param->isSet();
         }
 
-        //! Checks if all the required parameters are filled.
+        //! Checks if all the required parameters are filled. Only the active parameters are taken into account.
+        /**
+        The set of the missing parameters is updated along with the counters (see getCounters), so the check doesn't iterate over the optional parameters.
+        Only the required ones are re-checked, to take into account the changes that were made directly on them (i.e. a value assigned, or parsed by Param::parse).
+        */
         virtual bool hasRequiredFilled()
         {
-            std::map<std::string, Param*>::iterator itr;
-            for (itr = myParams.begin(); itr != myParams.end(); itr++) {
-                Param *param = itr->second;
-                if (param->isRequired && param->isActive() && !param->isSet()) {
-                    return false;
-                }
+            syncRequired();
+            std::vector<uint64_t>::const_iterator itr;
+            for (itr = missingRequired.begin(); itr != missingRequired.end(); ++itr) {
+                if (*itr) return false;
             }
             return true;
         }
 
+        //! Lists the names of the active required parameters that are not filled.
+        /**
+        \param names : the list to which the names are appended, in the order in which the parameters were added
+        \return number of the missing parameters
+        */
+        size_t listMissingRequired(OUT std::vector<std::string> &names)
+        {
+            syncRequired();
+            size_t count = 0;
+            for (size_t i = 0; i < missingRequired.size(); i++) {
+                uint64_t word = missingRequired[i];
+                for (size_t bit = 0; word; bit++, word >>= 1) {
+                    if (!(word & 1)) continue;
+                    names.push_back(paramsById[i * MISSING_WORD_BITS + bit]->argStr);
+                    count++;
+                }
+            }
+            return count;
+        }
+
         //! Deletes all the parameters groups.
         void releaseGroups()
         {
+            invalidateInfo();
             paramToGroup.clear();
             this->generalGroup = nullptr;
             std::map<std::string, ParamGroup*>::iterator itr;
@@ -218,116 +343,135 @@ namespace paramkit {
             paramGroups.clear();
         }
 
-        //! Deletes all the added parameters.
+        //! Deletes all the added parameters. The groups are kept, but emptied.
         void releaseParams()
         {
+            invalidateInfo();
+            paramToGroup.clear();
+            std::map<std::string, ParamGroup*>::iterator groupItr;
+            for (groupItr = paramGroups.begin(); groupItr != paramGroups.end(); ++groupItr) {
+                ParamGroup *group = groupItr->second;
+                group->params.clear();
+                group->counters.clear();
+            }
             std::map<std::string, Param*>::iterator itr;
             for (itr = myParams.begin(); itr != myParams.end(); itr++) {
                 Param *param = itr->second;
+                if (param->inArena) continue; // destroyed along with the arena
                 delete param;
             }
+            if (paramsArena == &ownArena) {
+                ownArena.release();
+            }
             myParams.clear();
+            paramsIndex.clear();
+            paramsById.clear();
+            requiredIds.clear();
+            missingRequired.clear();
+            similarNames.clear();
+            namesIndexed = false;
+            descriptionWords.clear();
+            descriptionsIndexed = false;
+            infoStrings.clear();
+            counters.clear();
         }
 
         //! Parses the parameters. Prints a warning if an undefined parameter was supplied.
+        /**
+        The arguments are not copied: the names are looked up, and the values passed to the parameters, directly from argv.
+        */
         template <typename T_CHAR>
         bool parse(int argc, T_CHAR* argv[])
         {
             bool helpRequested = false;
             size_t count = 0;
-            for (int i = 1; i < argc; i++) {
-                std::string param_str = to_string(argv[i]);
-                if (!isParam(param_str)) {
-                    printUnknownArgument(param_str);
+            ArgsStream<T_CHAR> args(argc, argv, responseFilesEnabled, responseFileStyle);
+            const T_CHAR *arg = nullptr;
+            while ((arg = args.next()) != nullptr) {
+                const T_CHAR *param_str = skipParamPrefix(arg);
+                if (!param_str) {
+                    printUnknownArgument(to_string(arg));
                     continue;
                 }
-                bool found = false;
-                param_str = skipParamPrefix(param_str);
 
-                std::map<std::string, Param*>::iterator itr;
-                for (itr = myParams.begin(); itr != myParams.end(); ++itr) {
-                    bool paramHelp = false;
-                    Param *param = itr->second;
-                    if (param_str == PARAM_HELP2 || param_str == PARAM_HELP1) {
-                        if (param_str == PARAM_HELP2) {
-                            const bool hasArg = (i + 1) < argc && !(isParam(to_string(argv[i + 1])));
-                            if (hasArg) {
-                                const std::string nextVal = to_string(argv[i + 1]);
-                                printHelp(nextVal, true);
-                                return false;
-                            }
+                // the built-in switches are resolved before the lookup:
+                const bool isHelp2 = util::is_tstr_equal(param_str, PARAM_HELP2, false);
+                if (isHelp2 || util::is_tstr_equal(param_str, PARAM_HELP1, false)) {
+                    if (isHelp2) {
+                        const T_CHAR *helpArg = args.peek();
+                        const bool hasArg = helpArg && !(isParam(helpArg));
+                        if (hasArg) {
+                            printHelp(to_string(helpArg), true);
+                            return false;
                         }
-                        const bool shouldExpand = (param_str == PARAM_HELP1) ? false : true;
-                        printHelp("", shouldExpand);
+                    }
+                    const bool shouldExpand = isHelp2;
+                    printHelp("", shouldExpand);
+                    return false;
+                }
+                if (this->versionStr.length()) {
+                    if (util::is_tstr_equal(param_str, PARAM_VERSION, false) || util::is_tstr_equal(param_str, PARAM_VERSION2, false)) {
+                        this->printVersionInfo();
                         return false;
                     }
-                    if (this->versionStr.length()) {
-                        if (param_str == PARAM_VERSION || param_str == PARAM_VERSION2) {
-                            this->printVersionInfo();
-                            return false;
-                        }
+                }
+
+                Param *param = findParam(param_str);
+                if (!param) {
+                    const std::string name = to_string(param_str);
+                    printUnknownParam(name);
+                    print_in_color(HILIGHTED_COLOR, "Similar parameters:\n");
+                    this->printInfo(false, name, true);
+                    return false;
+                }
+                count++;
+
+                if (!param->isActive()) {
+                    paramkit::print_in_color(RED, "WARNING: chosen inactive parameter: " + param->argStr + "\n");
+                }
+                // has an argument:
+                const T_CHAR *nextArg = args.peek();
+                const bool hasArg = nextArg && 
+                    ( param->requiredArg || !(isParam(nextArg)) );
+                if (hasArg) {
+                    const T_CHAR *nextVal = args.next(); // move to the next argument
+                    bool isParsed = false;
+                    bool paramHelp = false;
+
+                    if (util::is_tstr_equal(nextVal, PARAM_HELP1, false)) {
+                        paramHelp = true;
+                        helpRequested = true;
+                        isParsed = true;
                     }
-                    if (param_str == param->argStr) {
-                        if (!param->isActive()) {
-                            paramkit::print_in_color(RED, "WARNING: chosen inactive parameter: " + param_str + "\n");
-                        }
-                        // has an argument:
-                        const bool hasArg = (i + 1) < argc && 
-                            ( param->requiredArg || !(isParam(to_string(argv[i + 1]))) );
-                        if (hasArg) {
-                            const std::string nextVal = to_string(argv[i + 1]);
-                            i++; // increment index: move to the next argument
-                            found = true;
-                            bool isParsed = false;
-                            
-                            if (nextVal == PARAM_HELP1) {
-                                paramHelp = true;
-                                helpRequested = true;
-                                isParsed = true;
-                            }
-                            else {
-                                isParsed = param->parse(nextVal.c_str());
-                                if (!isParsed) {
-                                    paramHelp = true;
-                                    helpRequested = true;
-                                }
-                            }
-
-                            //help requested explicitly or parsing failed
-                            if (paramHelp) {
-                                if (!isParsed) {
-                                    paramkit::print_in_color(RED, "Parsing the parameter failed. Correct options:\n");
-                                }
-                                paramkit::print_in_color(RED, param_str);
-                                param->printDesc();
-                                break;
-                            }
-                            break;
+                    else {
+                        isParsed = param->parse(nextVal);
+                        param->notifyChanged(ParamListener::CHANGED_VALUE);
+                        if (!isParsed) {
+                            paramHelp = true;
+                            helpRequested = true;
                         }
-                        // does not require an argument:
-                        if (!param->requiredArg) {
-                            param->parse((char*)nullptr);
-                            found = true;
-                            break;
+                    }
+
+                    //help requested explicitly or parsing failed
+                    if (paramHelp) {
+                        if (!isParsed) {
+                            paramkit::print_in_color(RED, "Parsing the parameter failed. Correct options:\n");
                         }
-                        // requires an argument, but it is missing:
-                        paramkit::print_in_color(RED, param_str);
-                        paramHelp = true;
-                        helpRequested = true;
+                        paramkit::print_in_color(RED, param->argStr);
                         param->printDesc();
-                        found = true;
-                        break;
                     }
+                    continue;
                 }
-                if (found) {
-                    count++;
-                }
-                else {
-                    printUnknownParam(param_str);
-                    print_in_color(HILIGHTED_COLOR, "Similar parameters:\n");
-                    this->printInfo(false, param_str, true);
-                    return false;
+                // does not require an argument:
+                if (!param->requiredArg) {
+                    param->parse((char*)nullptr);
+                    param->notifyChanged(ParamListener::CHANGED_VALUE);
+                    continue;
                 }
+                // requires an argument, but it is missing:
+                paramkit::print_in_color(RED, param->argStr);
+                helpRequested = true;
+                param->printDesc();
             }
             if (helpRequested) {
                 return false;
@@ -345,6 +489,198 @@ namespace paramkit {
             return true;
         }
 
+        //! Loads the values of the parameters from the configuration file. The file is mapped into the memory, and read in a single pass.
+        /**
+        The keys are the names of the parameters, and the values are parsed as if they were given in the command line. A key without a value (INI), or with the null value (JSON), sets the parameter that doesn't require an argument.
+        The elements of the array (JSON) are joined with the delimiter of the list parameter. The parameters that are not lists accept at most one element.
+        The presence of the required parameters is not checked, as they may be given in the command line as well.
+        \param path : the path to the file
+        \param errors : the problems found in the file, with their line and column
+        \param format : the format of the file
+        \return true if the file was loaded without any problems
+        */
+        bool loadConfig(const std::string &path, OUT std::vector<ConfigError> &errors, t_config_format format = CONFIG_AUTO)
+        {
+            util::MappedFile file;
+            if (!file.open(path)) {
+                errors.push_back(ConfigError(0, 0, "Could not open the file: " + path));
+                return false;
+            }
+            return loadConfig(file.data(), file.size(), errors, format);
+        }
+
+        //! Loads the values of the parameters from the configuration given in the buffer. See: loadConfig(path, errors, format)
+        bool loadConfig(const char *buf, size_t len, OUT std::vector<ConfigError> &errors, t_config_format format = CONFIG_AUTO)
+        {
+            ConfigDispatcher dispatcher(*this);
+            util::ConfigReader reader(buf, len, format);
+            return reader.read(dispatcher, errors);
+        }
+
+        //! Enables or disables the expansion of the response files: the arguments in the form @<path> are replaced by the arguments read from the given files.
+        /**
+        The files are mapped into the memory, and read lazily, one argument at a time, so they may be of any size. If the file does not exist, the argument is passed as it is.
+        \param enable : the flag enabling the expansion
+        \param style : the rules by which the files are split into the arguments
+        */
+        void enableResponseFiles(bool enable = true, t_cmdline_style style = CMDLINE_NATIVE)
+        {
+            responseFilesEnabled = enable;
+            responseFileStyle = style;
+        }
+
+        //! Parses the parameters from the raw command line (starting from the program name). The command line is tokenized in place, so the arguments are not copied.
+        /**
+        \param cmdLine : the command line: a writeable, NUL-terminated buffer. It is modified by the tokenizer.
+        \param len : the length of the command line (without the terminating NUL)
+        \param style : the rules by which the command line is split into the arguments
+        */
+        template <typename T_CHAR>
+        bool parse(T_CHAR *cmdLine, size_t len, t_cmdline_style style = CMDLINE_NATIVE)
+        {
+            std::vector<T_CHAR*> argv;
+            CmdlineTokenizer<T_CHAR> tokenizer(cmdLine, len, style);
+            tokenizer.tokenize(argv);
+            return parse((int)argv.size(), argv.empty() ? nullptr : &argv[0]);
+        }
+
+        //! Parses the parameters from the raw command line (starting from the program name). The command line is copied once, and tokenized in the copy.
+        template <typename T_CHAR>
+        bool parse(const std::basic_string<T_CHAR> &cmdLine, t_cmdline_style style = CMDLINE_NATIVE)
+        {
+            std::vector<T_CHAR> buf(cmdLine.begin(), cmdLine.end());
+            buf.push_back(0);
+            return parse(&buf[0], cmdLine.length(), style);
+        }
+
+        //! Parses the raw command line (starting from the program name) into the given store of values, using the parameters only as the schema (see parseInto). The command line is tokenized in place.
+        template <typename T_CHAR>
+        bool parseInto(T_CHAR *cmdLine, size_t len, ParsedValues &values, t_cmdline_style style = CMDLINE_NATIVE) const
+        {
+            std::vector<T_CHAR*> argv;
+            CmdlineTokenizer<T_CHAR> tokenizer(cmdLine, len, style);
+            tokenizer.tokenize(argv);
+            return parseInto((int)argv.size(), argv.empty() ? nullptr : &argv[0], values);
+        }
+
+        //! Parses the arguments into the given store of values, using the parameters only as the schema: neither the parameters nor this object are modified, and nothing is printed.
+        /**
+        Allows to parse multiple command lines with the same schema, refilling the same (or a separate) store for each of them.
+        The schema can be shared by multiple threads, as long as it is not modified in the meantime.
+        \param argc : the number of the arguments
+        \param argv : the arguments (the first of them is skipped, as it is the name of the program)
+        \param values : the store that is reset and filled with the parsed values; the problems are reported as its diagnostics
+        \return true if all the arguments were parsed, and all the required parameters are filled
+        */
+        template <typename T_CHAR>
+        bool parseInto(int argc, T_CHAR* argv[], ParsedValues &values) const
+        {
+            values.reset(paramsById.size());
+            bool isOk = true;
+            ArgsStream<T_CHAR> args(argc, argv, responseFilesEnabled, responseFileStyle);
+            const T_CHAR *arg = nullptr;
+            while ((arg = args.next()) != nullptr) {
+                const int i = args.argIndex();
+                const T_CHAR *param_str = skipParamPrefix(arg);
+                if (!param_str) {
+                    values.addDiagnostic(DIAG_REDUNDANT_ARG, i, to_string(arg));
+                    continue;
+                }
+                if (util::is_tstr_equal(param_str, PARAM_HELP2, false) || util::is_tstr_equal(param_str, PARAM_HELP1, false)
+                    || (this->versionStr.length() && (util::is_tstr_equal(param_str, PARAM_VERSION, false) || util::is_tstr_equal(param_str, PARAM_VERSION2, false))))
+                {
+                    values.addDiagnostic(DIAG_HELP_REQUESTED, i, to_string(param_str));
+                    return false;
+                }
+                Param *param = findParam(param_str);
+                if (!param) {
+                    values.addDiagnostic(DIAG_UNKNOWN_PARAM, i, to_string(param_str));
+                    return false;
+                }
+                if (!param->isActive()) {
+                    values.addDiagnostic(DIAG_INACTIVE_PARAM, i, param->argStr);
+                }
+                const T_CHAR *nextArg = args.peek();
+                const bool hasArg = nextArg &&
+                    (param->requiredArg || !(isParam(nextArg)));
+                if (hasArg) {
+                    const T_CHAR *nextVal = args.next(); // move to the value
+                    if (util::is_tstr_equal(nextVal, PARAM_HELP1, false)) {
+                        values.addDiagnostic(DIAG_HELP_REQUESTED, args.argIndex(), param->argStr);
+                        return false;
+                    }
+                    if (!param->parseValue(nextVal, values.slot(param->denseId))) {
+                        values.addDiagnostic(DIAG_INVALID_VALUE, args.argIndex(), param->argStr);
+                        isOk = false;
+                    }
+                    continue;
+                }
+                if (!param->requiredArg) {
+                    param->parseValue((char*)nullptr, values.slot(param->denseId));
+                    continue;
+                }
+                values.addDiagnostic(DIAG_MISSING_VALUE, i, param->argStr);
+                isOk = false;
+            }
+            if (!checkRequiredFilled(values)) {
+                isOk = false;
+            }
+            values.isValid = isOk;
+            return isOk;
+        }
+
+        //! Parses a batch of command lines into separate stores of values, in parallel. Uses the parameters only as the schema (see parseInto).
+        /**
+        \param argvs : the argument vectors, one per command line (the first argument of each is skipped, as it is the name of the program)
+        \param results : the stores of the values, filled in the order of the argument vectors. Each of them holds the result of its parsing (isParsed), and the diagnostics.
+        \param threadsCount : the maximal number of the threads to be used, or 0 for the number of the hardware threads. The threads are kept for the next batches.
+        \return number of the command lines that were parsed successfuly
+        */
+        template <typename T_CHAR>
+        size_t parseBatch(const std::vector< std::vector<T_CHAR*> > &argvs, std::vector<ParsedValues> &results, size_t threadsCount = 0) const
+        {
+            // the own pool is created by the first batch, so the objects that never parse the batches don't pay for it:
+            std::call_once(batchPoolCreated, [this]() {
+                batchPool.reset(new util::WorkStealingPool());
+            });
+            return parseBatch(argvs, results, *batchPool, threadsCount);
+        }
+
+        //! Parses a batch of command lines into separate stores of values, in parallel, using the given pool of threads (i.e. shared with the other objects). See parseBatch.
+        template <typename T_CHAR>
+        size_t parseBatch(const std::vector< std::vector<T_CHAR*> > &argvs, std::vector<ParsedValues> &results, util::WorkStealingPool &pool, size_t threadsCount = 0) const
+        {
+            results.resize(argvs.size());
+            pool.run(argvs.size(), [this, &argvs, &results](size_t i) {
+                const std::vector<T_CHAR*> &args = argvs[i];
+                T_CHAR** argv = args.empty() ? nullptr : const_cast<T_CHAR**>(&args[0]);
+                parseInto((int)args.size(), argv, results[i]);
+            }, threadsCount);
+
+            size_t parsedCount = 0;
+            std::vector<ParsedValues>::const_iterator itr;
+            for (itr = results.begin(); itr != results.end(); ++itr) {
+                if (itr->isParsed()) parsedCount++;
+            }
+            return parsedCount;
+        }
+
+        //! Returns the dense index of the parameter with the given name (that is used to retrieve its value from the ParsedValues), or INVALID_PARAM_ID if such parameter does not exist.
+        size_t getParamId(const std::string &paramName) const
+        {
+            const Param *param = findParam(paramName.c_str());
+            if (!param) return INVALID_PARAM_ID;
+            return param->denseId;
+        }
+
+        //! Returns the parsed value of the parameter with the given name, or nullptr if such parameter does not exist
+        const ParsedValue* getValue(const ParsedValues &values, const std::string &paramName) const
+        {
+            const size_t id = getParamId(paramName);
+            if (id == INVALID_PARAM_ID) return nullptr;
+            return values.at(id);
+        }
+
         //! Prints the values of all the parameters that are currently set.
         void print()
         {
@@ -387,30 +723,222 @@ namespace paramkit {
             return true;
         }
 
+        //! Returns the counters of all the parameters: by categories, and by states
+        /**
+        The counters are updated when the parameters are added, parsed by Params, activated/deactivated, or set by setIntValue.
+        If a parameter was changed directly (i.e. its value was assigned, or parsed by Param::parse), call updateCounters to take it into account.
+        The required parameters are also recounted by hasRequiredFilled.
+        */
+        const ParamCounters& getCounters() const
+        {
+            return counters;
+        }
+
+        //! Takes into account the current state of the parameter (i.e. after its value was assigned directly)
+        void updateCounters(const std::string &paramName)
+        {
+            Param *param = getParam(paramName);
+            if (param) {
+                updateCounters(param);
+            }
+        }
+
     protected:
 
         virtual size_t countFilled(bool isRequired)
         {
-            size_t count = 0;
+            return counters.countFilled(isRequired);
+        }
+
+        //! Finds the parameters matching the filter: by the names (using the similarity index), and by the descriptions.
+        void fillFilter(ParamFilter &paramFilter)
+        {
+            if (paramFilter.isEmpty()) return;
+
+            if (!namesIndexed) {
+                indexNames();
+            }
+            std::vector<util::SimilarName> similar;
+            similarNames.find(paramFilter.filter, similar);
+            for (std::vector<util::SimilarName>::iterator itr = similar.begin(); itr != similar.end(); ++itr) {
+                paramFilter.addMatch(findParam(itr->name.c_str()), PARAM_SIMILAR_NAME);
+            }
+            if (!descriptionsIndexed) {
+                indexDescriptions();
+            }
+            std::set<size_t> ids;
+            descriptionWords.findTexts(paramFilter.filter, ids);
+            for (std::set<size_t>::iterator idItr = ids.begin(); idItr != ids.end(); ++idItr) {
+                Param *param = paramsById[*idItr];
+                if (paramFilter.hasMatch(param)) continue;
+
+                paramFilter.addMatch(param, PARAM_SIMILAR_DESC);
+            }
+        }
+
+        //! Builds the index of the names of all the parameters. Once built, it is updated when the parameters are added.
+        void indexNames()
+        {
+            similarNames.clear();
             std::map<std::string, Param*>::iterator itr;
-            for (itr = myParams.begin(); itr != myParams.end(); itr++) {
-                Param *param = itr->second;
-                if (param->isRequired != isRequired) continue;
-                if (param->isSet()) {
-                    count++;
+            for (itr = myParams.begin(); itr != myParams.end(); ++itr) {
+                similarNames.insert(itr->first);
+            }
+            namesIndexed = true;
+        }
+
+        //! Builds the index of the words used in the descriptions of all the parameters, by their dense indexes
+        void indexDescriptions()
+        {
+            descriptionWords.clear();
+            for (size_t id = 0; id < paramsById.size(); id++) {
+                paramsById[id]->indexKeywords(descriptionWords, id);
+            }
+            descriptionWords.build();
+            descriptionsIndexed = true;
+        }
+
+        //! Called when any of the parameters has changed
+        virtual void onParamChanged(Param *param, t_param_change change)
+        {
+            if (change == CHANGED_VALUE || change == CHANGED_ACTIVE) {
+                updateCounters(param);
+            }
+            if (change == CHANGED_VALUE) {
+                return; // the cached info doesn't depend on the values
+            }
+            if (change == CHANGED_INFO) {
+                internInfo(param);
+                descriptionsIndexed = false;
+            }
+            invalidateInfo();
+        }
+
+        //! Recounts the parameter in the counters of the container and of its group, according to its current state
+        void updateCounters(Param *param)
+        {
+            ParamGroup *group = nullptr;
+            std::map<Param*, ParamGroup*>::iterator itr = paramToGroup.find(param);
+            if (itr != paramToGroup.end()) {
+                group = itr->second;
+            }
+            counters.remove(param);
+            if (group) group->counters.remove(param);
+
+            ParamCounters::updateState(param);
+
+            counters.add(param);
+            if (group) group->counters.add(param);
+
+            updateMissingRequired(param);
+        }
+
+        //! Counts the required (and active) parameters that are filled in the given store, and reports the missing ones
+        bool checkRequiredFilled(ParsedValues &values) const
+        {
+            values.requiredFilled = 0;
+            bool isFilled = true;
+            std::vector<size_t>::const_iterator itr;
+            for (itr = requiredIds.begin(); itr != requiredIds.end(); ++itr) {
+                const Param *param = paramsById[*itr];
+                if (!param->isActive()) continue;
+                if (values.isSet(*itr)) {
+                    values.requiredFilled++;
+                    continue;
                 }
+                values.addDiagnostic(DIAG_MISSING_REQUIRED, -1, param->argStr);
+                isFilled = false;
             }
-            return count;
+            return isFilled;
         }
 
-        size_t _info(bool isRequired, bool hilightMissing, const std::string &filter, bool isExtended)
+        //! Replaces the descriptions of the parameter by their pooled equivalents, so that the repeated ones are stored only once
+        void internInfo(Param *param)
+        {
+            infoStrings.intern(param->typeDescStr);
+            infoStrings.intern(param->m_info);
+            infoStrings.intern(param->m_extInfo);
+        }
+
+        //! Recounts the required parameters which state has changed without a notification (i.e. a value was assigned directly, or isActive is overridden)
+        void syncRequired()
+        {
+            std::vector<size_t>::const_iterator itr;
+            for (itr = requiredIds.begin(); itr != requiredIds.end(); ++itr) {
+                Param *param = paramsById[*itr];
+                if (param->countedSet != param->isSet() || param->countedActive != param->isActive()) {
+                    updateCounters(param);
+                }
+            }
+        }
+
+        //! Removes the parameter that is replaced by another one with the same name: from its group, from the counters, and from the required ones. Then deletes it.
+        void releaseReplaced(Param *replaced)
+        {
+            std::map<Param*, ParamGroup*>::iterator itr = paramToGroup.find(replaced);
+            if (itr != paramToGroup.end()) {
+                itr->second->removeParam(replaced);
+                paramToGroup.erase(itr);
+            }
+            counters.remove(replaced);
+            setMissingRequired(replaced->denseId, false);
+            std::vector<size_t>::iterator idItr = std::find(requiredIds.begin(), requiredIds.end(), replaced->denseId);
+            if (idItr != requiredIds.end()) {
+                requiredIds.erase(idItr);
+            }
+            replaced->listener = nullptr;
+            if (!replaced->inArena) {
+                delete replaced; // the parameters created by emplaceParam are destroyed along with the arena
+            }
+        }
+
+        //! Updates the bit of the parameter in the set of the missing ones, according to the state in which it was counted
+        void updateMissingRequired(const Param *param)
+        {
+            const bool isMissing = param->isRequired && param->countedActive && !param->countedSet;
+            setMissingRequired(param->denseId, isMissing);
+        }
+
+        void setMissingRequired(size_t denseId, bool isMissing)
+        {
+            const size_t wordId = denseId / MISSING_WORD_BITS;
+            const uint64_t mask = (uint64_t)1 << (denseId % MISSING_WORD_BITS);
+            if (wordId >= missingRequired.size()) {
+                if (!isMissing) return;
+                missingRequired.resize(wordId + 1, 0);
+            }
+            if (isMissing) {
+                missingRequired[wordId] |= mask;
+            }
+            else {
+                missingRequired[wordId] &= ~mask;
+            }
+        }
+
+        //! Drops the cached info, so that it is rendered again on the next request
+        void invalidateInfo()
+        {
+            isInfoCached[0] = isInfoCached[1] = false;
+        }
+
+        void _renderInfo(ColoredText &out, bool hilightMissing, const std::string &filter, bool isExtended)
+        {
+            out.append("---\n");
+            ParamFilter paramFilter(filter);
+            fillFilter(paramFilter);
+            _info(out, true, hilightMissing, paramFilter, isExtended);
+            _info(out, false, hilightMissing, paramFilter, isExtended);
+            const bool extendedInfoS = (filter.empty() && !hilightMissing) ? isExtended : false;
+            printInfoSection(out, extendedInfoS);
+            out.append("---\n");
+        }
+
+        size_t _info(ColoredText &out, bool isRequired, bool hilightMissing, const ParamFilter &filter, bool isExtended)
         {
-            const bool has_filter = filter.length() > 0 ? true : false;
-            std::map<std::string, Param*>::iterator itr;
             size_t printed = 0;
             if (countCategory(isRequired) > 0) {
                 const std::string desc = isRequired ? "Required:" : "Optional:";
-                print_in_color(hdrColor, "\n"+ desc + "\n");
+                out.append(hdrColor, "\n"+ desc + "\n");
 
                 size_t total_count = 0;
                 bool printGroupName = (countGroups(isRequired, hilightMissing, filter)) ? true : false;
@@ -419,11 +947,11 @@ namespace paramkit {
                     for (groupItr = this->paramGroups.begin(); groupItr != paramGroups.end(); ++groupItr) {
                         ParamGroup* group = groupItr->second;
                         if (!group) continue; //should never happen
-                        printed += group->printGroup(printGroupName, isRequired, hilightMissing, filter, isExtended);
-                        total_count += group->countParams(isRequired, false, "");
+                        printed += group->printGroup(out, printGroupName, isRequired, hilightMissing, filter, isExtended);
+                        total_count += group->counters.countTotal(isRequired);
                     }
                     if (printed < total_count) {
-                        print_in_color(INACTIVE_COLOR, "\n[...]\n");
+                        out.append(INACTIVE_COLOR, "\n[...]\n");
                     }
                 }
             }
@@ -456,27 +984,31 @@ namespace paramkit {
             return true;
         }
 
-        void printInfoSection(bool isExtended)
+        void printInfoSection(bool isExtended) const
         {
-            if (isExtended) {
-                // make an example:
-                if (myParams.size()) {
-                    std::map<std::string, Param*>::iterator itr = myParams.begin();
-                    std::stringstream ss1;
-                    ss1 << INFO_SPACER << "Example: " << PARAM_SWITCH1 << itr->first << " ?";
-                    paramInfoP.m_extInfo = ss1.str();
-                }
+            ColoredText out;
+            printInfoSection(out, isExtended);
+            print_colored(out);
+        }
+
+        void printInfoSection(ColoredText &out, bool isExtended) const
+        {
+            out.append(hdrColor, "\nInfo:\n");
+            paramHelp.printInColor(paramColor, out);
+            paramHelp.printDesc(out, isExtended);
+            paramHelpP.printInColor(paramColor, out);
+            paramHelpP.printDesc(out, isExtended);
+            paramInfoP.printInColor(paramColor, out);
+            paramInfoP.printDesc(out, isExtended);
+            if (isExtended && myParams.size()) {
+                // make an example (without storing it in the parameter: rendering doesn't change the parameters)
+                std::stringstream ss1;
+                ss1 << INFO_SPACER << "Example: " << PARAM_SWITCH1 << myParams.begin()->first << " ?\n";
+                out.append(ss1.str());
             }
-            print_in_color(hdrColor, "\nInfo:\n");
-            paramHelp.printInColor(paramColor);
-            paramHelp.printDesc(isExtended);
-            paramHelpP.printInColor(paramColor);
-            paramHelpP.printDesc(isExtended);
-            paramInfoP.printInColor(paramColor);
-            paramInfoP.printDesc(isExtended);
             if (this->versionStr.length()) {
-                paramVersion.printInColor(paramColor);
-                paramVersion.printDesc(isExtended);
+                paramVersion.printInColor(paramColor, out);
+                paramVersion.printDesc(out, isExtended);
             }
         }
 
@@ -493,12 +1025,13 @@ namespace paramkit {
                     paramToGroup.erase(param);
                 }
             }
-            group->params.insert(param);
+            group->addParam(param);
             paramToGroup[param] = group;
+            invalidateInfo();
             return true;
         }
 
-        size_t countGroups(bool required, bool hilightMissing, const std::string &filter) const
+        size_t countGroups(bool required, bool hilightMissing, const ParamFilter &filter) const
         {
             size_t groups_count = 0;
             std::map<std::string, ParamGroup*>::const_iterator itr;
@@ -513,15 +1046,9 @@ namespace paramkit {
         }
 
         //! Returns the number of parameters of particular category: required or optional.
-        size_t countCategory(bool isRequired)
+        size_t countCategory(bool isRequired) const
         {
-            size_t count = 0;
-            std::map<std::string, Param*>::iterator itr;
-            for (itr = myParams.begin(); itr != myParams.end(); itr++) {
-                Param *param = itr->second;
-                if (param->isRequired == isRequired) count++;
-            }
-            return count;
+            return counters.countTotal(isRequired);
         }
 
         void printUnknownParam(const std::string &param)
@@ -546,39 +1073,149 @@ namespace paramkit {
             return nullptr;
         }
 
-        //! Checks if the string starts from the parameter switch.
-        static bool isParam(const std::string &str)
+        //! Retrieve the parameter by its unique name, given as a null-terminated string of any character type. Uses the dispatch index (a binary search in the table sorted by names), so the name is not copied. Returns nullptr if such parameter does not exist.
+        template <typename T_CHAR>
+        Param* findParam(const T_CHAR *name) const
         {
-            const size_t prefixLen = 1;
-            const size_t len = str.length();
-            if (len <= prefixLen) return false;
+            if (!name) return nullptr;
+            size_t start = 0;
+            size_t end = paramsIndex.size();
+            while (start < end) {
+                const size_t mid = start + (end - start) / 2;
+                const int cmp = util::tstr_compare(paramsIndex[mid]->argStr, name);
+                if (cmp == 0) {
+                    return paramsIndex[mid];
+                }
+                if (cmp < 0) {
+                    start = mid + 1;
+                }
+                else {
+                    end = mid;
+                }
+            }
+            return nullptr;
+        }
 
-            if (str[0] == PARAM_SWITCH1 || str[0] == PARAM_SWITCH2) {
-                return true;
+        //! Retrieve the parameter by its name given as a string of the given length (that doesn't need to be NUL-terminated), using the dispatch index. Returns nullptr if such parameter does not exist.
+        Param* findParam(const util::StringView &name) const
+        {
+            size_t start = 0;
+            size_t end = paramsIndex.size();
+            while (start < end) {
+                const size_t mid = start + (end - start) / 2;
+                const std::string &argStr = paramsIndex[mid]->argStr;
+                const int cmp = util::StringView(argStr.data(), argStr.length()).compare(name);
+                if (cmp == 0) {
+                    return paramsIndex[mid];
+                }
+                if (cmp < 0) {
+                    start = mid + 1;
+                }
+                else {
+                    end = mid;
+                }
             }
-            return false;
+            return nullptr;
         }
 
-        //! Skip the parameter prefix. Example: "/param", '-param', or "--param" is converted to "param".
-        std::string skipParamPrefix(std::string &str)
+        //! Inserts the parameter into the dispatch index, keeping it sorted by names. A parameter with the same name is replaced.
+        void indexParam(Param *param)
         {
-            size_t prefixLen = 1;
-            const size_t len = str.length();
-            if (len < prefixLen) return str;
+            std::vector<Param*>::iterator itr = std::lower_bound(paramsIndex.begin(), paramsIndex.end(), param, ParamCompare());
+            if (itr != paramsIndex.end() && (*itr)->argStr == param->argStr) {
+                *itr = param;
+                return;
+            }
+            paramsIndex.insert(itr, param);
+        }
 
-            if (str[0] != PARAM_SWITCH1 && str[0] != PARAM_SWITCH2) {
-                return str;
+        //! Passes the entries of the configuration file to the parameters
+        class ConfigDispatcher : public util::ConfigHandler {
+        public:
+            ConfigDispatcher(Params &_params)
+                : params(_params)
+            {
             }
-            if (len > 2 && str[0] == PARAM_SWITCH2) {
-                if (str[1] == PARAM_SWITCH2) { // double prefix: "--", i.e. "--param"
-                    prefixLen = 2;
+
+            virtual bool onEntry(const util::StringView &key, const char *value, std::string &errorMsg)
+            {
+                Param *param = params.findParam(key);
+                if (!param) {
+                    errorMsg = "Invalid parameter: " + key.str();
+                    return false;
+                }
+                if (!value && param->requiredArg) {
+                    errorMsg = "Missing the value of the parameter: " + param->argStr;
+                    return false;
                 }
+                const bool isParsed = param->parse(value);
+                param->notifyChanged(ParamListener::CHANGED_VALUE);
+                if (!isParsed) {
+                    errorMsg = "Invalid value of the parameter: " + param->argStr;
+                    return false;
+                }
+                return true;
             }
-            return str.substr(prefixLen); // skip the first char
+
+            virtual std::string listDelimiter(const util::StringView &key)
+            {
+                const Param *param = params.findParam(key);
+                if (!param) {
+                    return ","; // the entry is rejected anyway
+                }
+                const StringListParam *listParam = dynamic_cast<const StringListParam*>(param);
+                if (listParam) {
+                    return listParam->delimiter;
+                }
+                const FlagsParam *flagsParam = dynamic_cast<const FlagsParam*>(param);
+                if (flagsParam) {
+                    return std::string(1, flagsParam->delimiter);
+                }
+                return "";
+            }
+
+        protected:
+            Params &params;
+        };
+
+        //! Checks if the string starts from the parameter switch.
+        template <typename T_CHAR>
+        static bool isParam(const T_CHAR *str)
+        {
+            return skip_param_prefix(str) != nullptr;
+        }
+
+        //! Skip the parameter prefix. Example: "/param", '-param', or "--param" is converted to "param". Returns nullptr if the string is not a parameter.
+        template <typename T_CHAR>
+        static const T_CHAR* skipParamPrefix(const T_CHAR *str)
+        {
+            return skip_param_prefix(str);
         }
 
         std::string versionStr;
+        bool responseFilesEnabled; ///< if set, the arguments in the form @<path> are expanded
+        t_cmdline_style responseFileStyle;
+        util::MonotonicArena ownArena; ///< the default arena of the parameters created by emplaceParam
+        util::MonotonicArena *paramsArena; ///< the arena in use: own, or supplied by the caller
         std::map<std::string, Param*> myParams;
+        std::vector<Param*> paramsIndex; ///< the dispatch index: all the parameters, sorted by their names
+        util::SimilarityIndex similarNames; ///< the index of the parameters' names, used to find the ones similar to the given string: built when needed
+        bool namesIndexed; ///< true if the similarNames are up to date
+        util::KeywordIndex descriptionWords; ///< the index of the words used in the descriptions: built when needed, by the dense indexes of the parameters
+        bool descriptionsIndexed; ///< true if the descriptionWords are up to date
+        ParamCounters counters; ///< the numbers of all the parameters, by categories
+        util::StringPool infoStrings; ///< the descriptions of the parameters: the repeated ones are stored only once
+        mutable std::unique_ptr<util::WorkStealingPool> batchPool; ///< the threads parsing the batches of the command lines: created by the first batch
+        mutable std::once_flag batchPoolCreated;
+
+        static const size_t MISSING_WORD_BITS = 64;
+        std::vector<Param*> paramsById; ///< all the added parameters, by their dense indexes
+        std::vector<size_t> requiredIds; ///< the dense indexes of the required parameters, sorted: they are re-checked at the end of parsing
+        std::vector<uint64_t> missingRequired; ///< the bitset of the parameters that are required, active, and not set: indexed by their dense indexes
+
+        ColoredText cachedInfo[2]; ///< the rendered info of all the parameters: brief, and extended
+        bool isInfoCached[2]; ///< true if the corresponding cachedInfo is up to date
+        ColoredText uncachedInfo; ///< the last rendered info that could not be cached
 
         BoolParam paramHelp;
         StringParam paramHelpP;
@@ -0,0 +1,171 @@
+/**
+* @file
+* @brief   The values parsed from a command line, stored separately from the parameters (the schema)
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace paramkit {
+
+    //! The value of a single parameter. Which of the fields is used depends on the type of the parameter.
+    struct ParsedValue {
+        ParsedValue()
+            : isSet(false), number(0)
+        {
+        }
+
+        //! Clears the value. The capacity of the strings is kept, so they can be refilled without allocating.
+        void clear()
+        {
+            isSet = false;
+            number = 0;
+            str.clear();
+            wstr.clear();
+            numbers.clear();
+        }
+
+        bool isSet;
+        uint64_t number; ///< IntParam: the number; EnumParam: the enum value; BoolParam: 0 or 1
+        std::string str; ///< StringParam and the lists: the string
+        std::wstring wstr; ///< WStringParam: the wide string
+        std::vector<uint64_t> numbers; ///< IntListParam: the elements of the list
+    };
+
+    //! The kinds of the problems reported while parsing into the ParsedValues
+    typedef enum {
+        DIAG_UNKNOWN_PARAM = 0, ///< the parameter is not defined
+        DIAG_REDUNDANT_ARG, ///< the argument is not preceded by a parameter
+        DIAG_INVALID_VALUE, ///< parsing the value of the parameter failed
+        DIAG_MISSING_VALUE, ///< the parameter requires a value, but none was given
+        DIAG_INACTIVE_PARAM, ///< the parameter is inactive (a warning: the value is stored anyway)
+        DIAG_MISSING_REQUIRED, ///< the required parameter was not given
+        DIAG_HELP_REQUESTED, ///< the help or the version was requested: the parsing stopped
+        DIAG_TYPES_COUNT
+    } t_diag_type;
+
+    //! The problem reported while parsing
+    struct ParseDiagnostic {
+        t_diag_type type;
+        int argIndex; ///< the index of the argument that caused the problem, or -1 if not related to any
+        std::string name; ///< the name of the parameter, or the argument that caused the problem
+    };
+
+    //! The values parsed from a single command line, indexed by the dense indexes of the parameters. Cheap to reset and refill with another command line.
+    class ParsedValues {
+    public:
+        ParsedValues()
+            : requiredFilled(0), isValid(false)
+        {
+        }
+
+        //! Prepares the store for parsing a new command line with the schema of the given number of parameters. Only the previously filled values are cleared.
+        void reset(size_t paramsCount)
+        {
+            std::vector<size_t>::iterator itr;
+            for (itr = touchedIds.begin(); itr != touchedIds.end(); ++itr) {
+                if (*itr < values.size()) {
+                    values[*itr].clear();
+                    touched[*itr] = false;
+                }
+            }
+            touchedIds.clear();
+            if (values.size() != paramsCount) {
+                values.resize(paramsCount);
+                touched.resize(paramsCount, false);
+            }
+            diagnostics.clear();
+            requiredFilled = 0;
+            isValid = false;
+        }
+
+        size_t size() const
+        {
+            return values.size();
+        }
+
+        bool isSet(size_t id) const
+        {
+            return id < values.size() && values[id].isSet;
+        }
+
+        //! Returns the value of the parameter with the given dense index, or nullptr if the index is out of the scope
+        const ParsedValue* at(size_t id) const
+        {
+            if (id >= values.size()) return nullptr;
+            return &values[id];
+        }
+
+        //! Returns the result of the last parsing: true if all the arguments were parsed, and all the required parameters are filled
+        bool isParsed() const
+        {
+            return isValid;
+        }
+
+        //! Returns the number of the values that are set
+        size_t countSet() const
+        {
+            size_t count = 0;
+            std::vector<size_t>::const_iterator itr;
+            for (itr = touchedIds.begin(); itr != touchedIds.end(); ++itr) {
+                if (values[*itr].isSet) count++;
+            }
+            return count;
+        }
+
+        //! Returns the number of the required (and active) parameters that are set
+        size_t countRequiredFilled() const
+        {
+            return requiredFilled;
+        }
+
+        //! Returns all the problems reported during the last parsing
+        const std::vector<ParseDiagnostic>& getDiagnostics() const
+        {
+            return diagnostics;
+        }
+
+        //! Checks if any problem of the given type was reported
+        bool hasDiagnostic(t_diag_type type) const
+        {
+            std::vector<ParseDiagnostic>::const_iterator itr;
+            for (itr = diagnostics.begin(); itr != diagnostics.end(); ++itr) {
+                if (itr->type == type) return true;
+            }
+            return false;
+        }
+
+    protected:
+        //! Returns the slot to be filled with the value of the parameter with the given dense index. Remembers it, so that it will be cleared on reset.
+        ParsedValue& slot(size_t id)
+        {
+            if (!touched[id]) {
+                touched[id] = true;
+                touchedIds.push_back(id);
+            }
+            return values[id];
+        }
+
+        void addDiagnostic(t_diag_type type, int argIndex, const std::string &name)
+        {
+            ParseDiagnostic diag;
+            diag.type = type;
+            diag.argIndex = argIndex;
+            diag.name = name;
+            diagnostics.push_back(diag);
+        }
+
+        std::vector<ParsedValue> values;
+        std::vector<bool> touched; ///< the flags of the values that were filled since the last reset
+        std::vector<size_t> touchedIds; ///< the indexes of the values that were filled: only they need to be cleared on reset
+        std::vector<ParseDiagnostic> diagnostics;
+        size_t requiredFilled; ///< the number of the required (and active) parameters that are set
+        bool isValid; ///< the result of the last parsing
+
+        friend class Params;
+    };
+
+};
@@ -5,31 +5,81 @@
 
 #pragma once
 
-#include <windows.h>
-
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <map>
 #include <set>
+#include <cstring>
+#include <climits>
+#include <stdint.h>
 
 #include "strings_util.h"
+#include "colored_text.h"
 
 #define GETNAME(x) (#x)
 
+// annotations of the arguments' direction (as in the Windows headers):
+#ifndef IN
+#define IN
+#endif
+#ifndef OUT
+#define OUT
+#endif
+
 namespace paramkit {
 
+    //! The base in which a number is given
+    typedef enum {
+        NUM_BASE_ANY = 0, ///< decimal, or hexadecimal with the "0x" prefix
+        NUM_BASE_DEC = 1, ///< decimal only
+        NUM_BASE_HEX = 2, ///< hexadecimal, with or without the "0x" prefix
+        NUM_BASE_COUNT
+    } t_num_base;
+
+    //! Flags describing the characters of a string, returned by scan_digits
+    typedef enum {
+        DIGITS_NONE = 0, ///< the string contains characters that are not hexadecimal digits
+        DIGITS_DEC = 1, ///< all the characters are decimal digits
+        DIGITS_HEX = 2 ///< all the characters are hexadecimal digits
+    } t_digits_flags;
+
+    //! Classifies all the characters of the buffer in one pass. Uses vectorized (SSE2/AVX2) kernels if the CPU supports them. Returns a combination of t_digits_flags.
+    int scan_digits(const char *buf, size_t len);
+
+    //! The implementations of scan_digits
+    typedef enum {
+        SCAN_IMPL_AUTO = 0, ///< the fastest one supported by the CPU
+        SCAN_IMPL_SCALAR,
+        SCAN_IMPL_SSE2,
+        SCAN_IMPL_AVX2,
+        SCAN_IMPL_COUNT
+    } t_scan_impl;
+
+    //! Classifies the characters with the chosen implementation of scan_digits, regardless of the length of the buffer. Allows to compare the kernels with each other.
+    /**
+    \return false if the implementation is not available (on this platform, or on this CPU)
+    */
+    bool scan_digits_with(t_scan_impl impl, const char *buf, size_t len, OUT int &flags);
+
+    //! Checks in one pass if the buffer contains a number: decimal, or hexadecimal with the "0x" prefix. If so, returns true and fills the detected base.
+    bool detect_number_base(const char *buf, size_t len, OUT t_num_base &base);
+
     bool is_hex(const char *buf, size_t len);
     bool is_hex_with_prefix(const char *buf);
     bool is_dec(const char *buf, size_t len);
     bool is_number(const char* my_buf);
+    //! Parses the number: decimal, or hexadecimal with the "0x" prefix. Returns 0 if the string is not a valid number, or if the number doesn't fit in long (use load_number to get the full 64-bit range).
     long get_number(const char *my_buf);
 
     size_t strip_to_list(IN std::string s, IN std::string delim, OUT std::set<std::string> &elements_list);
     std::string& trim(std::string& str, const std::string& chars = "\t\n\v\f\r ");
 
-    bool get_console_color(HANDLE hConsole, int& color);
+    //! Prints the text in the given color. The way of printing is chosen by the TermSink, depending on the capabilities of the terminal.
     void print_in_color(int color, const std::string &text);
+
+    //! Prints the whole text with its colored ranges
+    void print_colored(const ColoredText &text);
     //--
 
     template <typename T_CHAR>
@@ -45,43 +95,92 @@ namespace paramkit {
         return val;
     }
 
+    //! Parses the number from the string of the given length (that doesn't need to be null-terminated), in the full 64-bit range.
+    /**
+    The digits are validated with scan_digits, so the long numbers are checked by the vectorized kernels.
+    \param str : the string to be parsed
+    \param len : the length of the string
+    \param out : the parsed value. Not modified if the parsing failed.
+    \param base : the base in which the number is given
+    \return true if the whole string was a valid number that fits in 64 bits, false otherwise
+    */
+    bool load_number(IN const char *str, IN size_t len, OUT uint64_t &out, IN t_num_base base = NUM_BASE_ANY);
+
+    //! Parses the number from the string of the given length (that doesn't need to be null-terminated), in the full 64-bit range.
+    /**
+    The characters are narrowed into a local buffer, and parsed by the same function as the narrow strings.
+    \param str : the string to be parsed
+    \param len : the length of the string
+    \param out : the parsed value. Not modified if the parsing failed.
+    \param base : the base in which the number is given
+    \return true if the whole string was a valid number that fits in 64 bits, false otherwise
+    */
     template <typename T_CHAR>
-    int loadInt(const T_CHAR *str1, bool isHex = false)
+    bool load_number(IN const T_CHAR *str, IN size_t len, OUT uint64_t &out, IN t_num_base base = NUM_BASE_ANY)
     {
-        std::string str = to_string(str1);
-        int intVal = 0;
-        std::stringstream ss;
-        if (isHex) {
-            ss << std::hex << str;
+        if (!str) return false;
+
+        char localBuf[128];
+        std::string heapBuf;
+        char *buf = localBuf;
+        if (len > sizeof(localBuf)) { // i.e. a number with many leading zeros
+            heapBuf.resize(len);
+            buf = &heapBuf[0];
         }
-        else {
-            ss << std::dec << str;
+        for (size_t i = 0; i < len; i++) {
+            if ((unsigned long)str[i] > 0x7f) return false; // non-ASCII: not a digit
+            buf[i] = (char)str[i];
         }
-        ss >> intVal;
-        return intVal;
+        return load_number((const char*)buf, len, out, base);
+    }
+
+    //! Parses the number from the null-terminated string, in the full 64-bit range. Doesn't depend on the locale, and doesn't allocate memory.
+    /**
+    \param str : the string to be parsed
+    \param out : the parsed value. Not modified if the parsing failed.
+    \param base : the base in which the number is given
+    \return true if the whole string was a valid number that fits in 64 bits, false otherwise
+    */
+    template <typename T_CHAR>
+    bool load_number(IN const T_CHAR *str, OUT uint64_t &out, IN t_num_base base = NUM_BASE_ANY)
+    {
+        if (!str) return false;
+        size_t len = 0;
+        while (str[len] != 0) len++;
+        return load_number(str, len, out, base);
+    }
+
+    //! Parses the number from the null-terminated string. Returns 0 if the string is not a valid number, or if the number doesn't fit in int (use load_number to get the full 64-bit range).
+    template <typename T_CHAR>
+    int loadInt(const T_CHAR *str1, bool isHex = false)
+    {
+        uint64_t val = 0;
+        if (!load_number(str1, val, isHex ? NUM_BASE_HEX : NUM_BASE_DEC) || val > INT_MAX) {
+            return 0;
+        }
+        return (int)val;
     }
 
     template <typename T_CHAR>
     bool loadBoolean(IN const T_CHAR *str1, OUT bool &value)
     {
-        std::string str = to_string(str1);
-        if (util::strequals(str, "True") || util::strequals(str, "on") || util::strequals(str, "yes")) {
+        if (!str1) return false;
+        if (util::is_tstr_equal(str1, "True") || util::is_tstr_equal(str1, "on") || util::is_tstr_equal(str1, "yes")) {
             value = true;
             return true;
         }
-        if (util::strequals(str, "False") || util::strequals(str, "off") || util::strequals(str, "no")) {
+        if (util::is_tstr_equal(str1, "False") || util::is_tstr_equal(str1, "off") || util::is_tstr_equal(str1, "no")) {
             value = false;
             return true;
         }
-        if (!is_dec(str.c_str(), str.length())) {
-            return false;
-        }
-        const int val = loadInt(str.c_str(), false);
-        if (val == 0) {
+        // a decimal number: 0 or 1 (leading zeros allowed)
+        size_t i = 0;
+        for (; str1[i] == '0'; i++);
+        if (i > 0 && str1[i] == 0) {
             value = false;
             return true;
         }
-        if (val == 1) {
+        if (str1[i] == '1' && str1[i + 1] == 0) {
             value = true;
             return true;
         }
@@ -0,0 +1,217 @@
+/**
+* @file
+* @brief   The immutable strings that are cheap to store and copy: either referencing the static storage (i.e. literals), or sharing a reference-counted copy
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <set>
+#include <atomic>
+
+namespace paramkit {
+
+    namespace util {
+
+        //! The header of the shared copy of a string: the characters (terminated by NUL) follow it in the same block
+        struct SharedText {
+            std::atomic<size_t> refs; ///< the number of the PooledStrings referencing this copy
+            size_t len;
+
+            const char* chars() const
+            {
+                return reinterpret_cast<const char*>(this + 1);
+            }
+        };
+
+        //! Creates the shared copy of the given string, with a single reference
+        SharedText* make_shared_text(const char *str, size_t len);
+
+        //! Releases a reference to the shared copy. The copy is freed along with its last reference.
+        void release_shared_text(SharedText *shared);
+
+        //! Returns the number of the shared copies that are currently allocated
+        size_t shared_texts_count();
+
+        //! The immutable string that is cheap to store: it references a literal, or a shared copy.
+        /**
+        The shared copies are reference counted, without a lock: copying the string only increments the counter.
+        The copy is freed when the last PooledString referencing it is destroyed or cleared.
+        Equal strings are stored only once if they are interned in the same StringPool.
+        */
+        class PooledString {
+        public:
+            PooledString()
+                : data(""), len(0), shared(nullptr)
+            {
+            }
+
+            //! Creates the string referencing the shared copy of the given one
+            PooledString(const std::string &str)
+                : data(""), len(0), shared(nullptr)
+            {
+                assign(str.c_str(), str.length());
+            }
+
+            //! Creates the string referencing the shared copy of the given one. The given string may be temporary.
+            PooledString(const char *str)
+                : data(""), len(0), shared(nullptr)
+            {
+                if (str) assign(str, strlen(str));
+            }
+
+            PooledString(const PooledString &other)
+                : data(other.data), len(other.len), shared(other.shared)
+            {
+                if (shared) shared->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            PooledString& operator=(const PooledString &other)
+            {
+                if (this == &other) return *this;
+
+                if (other.shared) other.shared->refs.fetch_add(1, std::memory_order_relaxed);
+                clear();
+                data = other.data;
+                len = other.len;
+                shared = other.shared;
+                return *this;
+            }
+
+            ~PooledString()
+            {
+                clear();
+            }
+
+            //! Creates the string referencing the given static storage (i.e. a literal) directly, without copying it
+            static PooledString fromStatic(const char *literal)
+            {
+                return fromStatic(literal, literal ? strlen(literal) : 0);
+            }
+
+            //! Creates the string referencing the given number of characters of the static storage directly, without copying them
+            static PooledString fromStatic(const char *literal, size_t length)
+            {
+                PooledString pooled;
+                if (literal) {
+                    pooled.data = literal;
+                    pooled.len = length;
+                }
+                return pooled;
+            }
+
+            //! Makes the string empty, releasing the shared copy (if any)
+            void clear()
+            {
+                if (shared) {
+                    release_shared_text(shared);
+                    shared = nullptr;
+                }
+                data = "";
+                len = 0;
+            }
+
+            //! Returns true if the string references a shared copy, false if it references the static storage
+            bool isShared() const
+            {
+                return shared != nullptr;
+            }
+
+            const char* c_str() const
+            {
+                return data;
+            }
+
+            size_t length() const
+            {
+                return len;
+            }
+
+            bool empty() const
+            {
+                return len == 0;
+            }
+
+            //! Returns a copy of the content
+            std::string str() const
+            {
+                return std::string(data, len);
+            }
+
+            bool operator==(const PooledString &other) const
+            {
+                if (len != other.len) return false;
+                return data == other.data || memcmp(data, other.data, len) == 0;
+            }
+
+            bool operator!=(const PooledString &other) const
+            {
+                return !(*this == other);
+            }
+
+            //! Compares the contents
+            bool operator<(const PooledString &other) const
+            {
+                const int res = memcmp(data, other.data, (len < other.len) ? len : other.len);
+                if (res != 0) return res < 0;
+                return len < other.len;
+            }
+
+        protected:
+            void assign(const char *str, size_t length)
+            {
+                if (!length) return;
+                shared = make_shared_text(str, length);
+                data = shared->chars();
+                len = length;
+            }
+
+            const char *data;
+            size_t len;
+            SharedText *shared; ///< the shared copy referenced by this string, or nullptr if it references the static storage
+        };
+
+        inline std::ostream& operator<<(std::ostream &os, const PooledString &str)
+        {
+            return os.write(str.c_str(), str.length());
+        }
+
+        //! The set of the shared strings, in which the equal strings are stored only once. Not synchronized: it is owned by a single container of the parameters.
+        /**
+        The pool keeps a reference to each interned string, so they are freed only after the pool is cleared, and all the other references are released.
+        */
+        class StringPool {
+        public:
+            //! Replaces the given string by its pooled equivalent, adding it to the pool if it was not there. The strings referencing the static storage are kept as they are.
+            void intern(PooledString &str)
+            {
+                if (!str.isShared()) return;
+
+                std::set<PooledString>::const_iterator itr = strings.find(str);
+                if (itr == strings.end()) {
+                    strings.insert(str);
+                    return;
+                }
+                str = *itr;
+            }
+
+            //! Returns the number of the distinct strings in the pool
+            size_t size() const
+            {
+                return strings.size();
+            }
+
+            void clear()
+            {
+                strings.clear();
+            }
+
+        protected:
+            std::set<PooledString> strings;
+        };
+
+    }; //namespace util
+
+}; //namespace paramkit
@@ -0,0 +1,151 @@
+/**
+* @file
+* @brief   The indexes of strings: allowing to find names similar to the given string, and keywords occurring in descriptions
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <stdint.h>
+
+#include "strings_util.h"
+
+namespace paramkit {
+
+    namespace util {
+
+        //! A name found by the SimilarityIndex, along with the kind of the similarity
+        struct SimilarName {
+            std::string name;
+            stringsim_type simType;
+            size_t distance; ///< the Levenshtein distance from the query (if calculated), used for ranking
+        };
+
+        //! The index of names, finding the ones for which is_string_similar is true, without comparing the query with all of them.
+        /**
+        The candidates are collected from:
+        - a BK-tree keyed on the Levenshtein distance (SIM_LAV_DIST),
+        - an index of trigrams, and of the shorter substrings for the short queries (SIM_SUBSTR),
+        - buckets of names having the same set of characters (SIM_HIST),
+        and then verified with is_string_similar.
+        */
+        class SimilarityIndex {
+        public:
+            SimilarityIndex()
+                : maxNameLen(0)
+            {
+            }
+
+            //! Adds the name into the index. Returns false if it was already indexed.
+            bool insert(const std::string &name);
+
+            //! Removes all the names from the index
+            void clear();
+
+            size_t size() const
+            {
+                return names.size();
+            }
+
+            //! Finds the names similar to the filter, ranked from the most similar
+            /**
+            \param filter : the string to be searched
+            \param found : the found names
+            \param maxCount : the maximal number of the results (top-k), or 0 for all of them
+            \return number of the found names
+            */
+            size_t find(const std::string &filter, std::vector<SimilarName> &found, size_t maxCount = 0) const;
+
+        protected:
+            typedef uint32_t t_trigram;
+
+            struct BkNode {
+                size_t nameId;
+                std::map<size_t, size_t> children; ///< distance -> node index
+            };
+
+            void collectByDistance(const std::string &filter, size_t radius, std::set<size_t> &candidates) const;
+            void collectBySubstring(const std::string &lowFilter, std::set<size_t> &candidates) const;
+            void collectByCharset(const CharsetSignature &filterCharset, std::set<size_t> &candidates) const;
+
+            static void makeTrigrams(const std::string &lowStr, std::vector<t_trigram> &trigrams);
+
+            //! Makes the substrings of the length 1 and 2 (for the queries that are too short to have trigrams)
+            static void makeShortGrams(const std::string &lowStr, std::vector<t_trigram> &grams);
+
+            std::vector<std::string> names;
+            std::map<std::string, size_t> nameToId;
+
+            std::vector<BkNode> bkTree; ///< the first node is the root
+
+            std::map<t_trigram, std::vector<size_t> > trigramToIds;
+            std::vector<size_t> idToTrigramsCount;
+            std::vector<size_t> shortIds; ///< names that are too short to have trigrams
+            std::map<t_trigram, std::vector<size_t> > shortGramToIds; ///< the substrings of the length 1 and 2
+            size_t maxNameLen; ///< the length of the longest name: limits the distances that must be searched
+
+            std::vector<CharsetSignature> idToCharset;
+            std::map<CharsetSignature, std::vector<size_t> > charsetToIds;
+        };
+
+        //! The index of the words occurring in many texts, identified by the numbers. Finds the texts containing the keyword, without checking them one by one.
+        /**
+        The words are normalized to lowercase, and stored once, in a single buffer. The index is a suffix array: the offsets of all the suffixes of the words, sorted, so the keyword may occur anywhere inside a word, and is found with a binary search.
+        If the keyword consists of multiple words, each of them must occur in the text.
+        */
+        class KeywordIndex {
+        public:
+            KeywordIndex()
+                : isBuilt(true)
+            {
+            }
+
+            //! Adds all the words of the text, as occurring in the text with the given id. The texts must be added in the order of their ids. Call build() when all of them are added.
+            void addText(const std::string &text, size_t textId)
+            {
+                addText(text.c_str(), text.length(), textId);
+            }
+
+            //! Adds all the words of the text (of the given length), as occurring in the text with the given id
+            void addText(const char *text, size_t len, size_t textId);
+
+            //! Sorts the suffixes of the added words, so that they can be searched
+            void build();
+
+            //! Removes all the words from the index
+            void clear();
+
+            //! Finds the texts in which all the words of the keyword occur. The index must be built.
+            /**
+            \param keyword : the keyword to be searched
+            \param textIds : the ids of the found texts
+            \return number of the found texts
+            */
+            size_t findTexts(const std::string &keyword, std::set<size_t> &textIds) const;
+
+            //! Splits the text into lowercase words (sequences of alphanumeric characters and underscores)
+            static size_t splitWords(const std::string &text, std::vector<std::string> &words)
+            {
+                return splitWords(text.c_str(), text.length(), words);
+            }
+
+            //! Splits the text (of the given length) into lowercase words
+            static size_t splitWords(const char *text, size_t len, std::vector<std::string> &words);
+
+        protected:
+            //! Returns the id of the text containing the word at the given offset
+            size_t findTextId(size_t offset) const;
+
+            std::string words; ///< the lowercase words of all the texts, each of them terminated by NUL
+            std::vector<uint32_t> suffixes; ///< the offsets of all the suffixes of the words: sorted by build()
+            std::vector<size_t> textOffsets; ///< the offsets at which the words of the consecutive texts start
+            std::vector<size_t> textIds; ///< the ids of the consecutive texts
+            bool isBuilt; ///< true if the suffixes are sorted
+        };
+
+    }; //namespace util
+
+}; //namespace paramkit
@@ -0,0 +1,105 @@
+/**
+* @file
+* @brief   Read-only views of a contiguous array, and of a string, that don't own the elements
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <stddef.h>
+
+namespace paramkit {
+
+    namespace util {
+
+        //! A read-only view of a contiguous array of elements. It doesn't own the elements: it is valid as long as the array is not modified.
+        template <typename T>
+        class Span {
+        public:
+            typedef const T* const_iterator;
+
+            Span()
+                : ptr(nullptr), count(0)
+            {
+            }
+
+            Span(const T *_ptr, size_t _count)
+                : ptr(_ptr), count(_count)
+            {
+            }
+
+            Span(const std::vector<T> &vec)
+                : ptr(vec.empty() ? nullptr : &vec[0]), count(vec.size())
+            {
+            }
+
+            const T* data() const { return ptr; }
+            size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+
+            const_iterator begin() const { return ptr; }
+            const_iterator end() const { return ptr + count; }
+
+            const T& operator[](size_t i) const { return ptr[i]; }
+
+        protected:
+            const T *ptr;
+            size_t count;
+        };
+
+        //! A read-only view of a part of a string. It doesn't own the characters, and it is not NUL-terminated.
+        class StringView : public Span<char> {
+        public:
+            StringView()
+                : Span<char>()
+            {
+            }
+
+            StringView(const char *_ptr, size_t _len)
+                : Span<char>(_ptr, _len)
+            {
+            }
+
+            size_t length() const { return count; }
+
+            //! Returns a copy of the viewed characters
+            std::string str() const
+            {
+                return ptr ? std::string(ptr, count) : std::string();
+            }
+
+            //! Compares the views as the strings (lexicographically). Returns a value less than, equal to, or greater than zero, as strcmp.
+            int compare(const StringView &other) const
+            {
+                const size_t minLen = (count < other.count) ? count : other.count;
+                const int res = minLen ? memcmp(ptr, other.ptr, minLen) : 0;
+                if (res != 0) return res;
+                if (count == other.count) return 0;
+                return (count < other.count) ? (-1) : 1;
+            }
+
+            bool operator==(const StringView &other) const { return compare(other) == 0; }
+            bool operator!=(const StringView &other) const { return compare(other) != 0; }
+            bool operator<(const StringView &other) const { return compare(other) < 0; }
+
+            bool operator==(const char *other) const
+            {
+                if (!other) return false;
+                return compare(StringView(other, strlen(other))) == 0;
+            }
+        };
+
+        inline std::ostream& operator<<(std::ostream &os, const StringView &view)
+        {
+            if (view.data()) {
+                os.write(view.data(), view.length());
+            }
+            return os;
+        }
+
+    }; //namespace util
+
+}; //namespace paramkit
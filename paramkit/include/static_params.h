@@ -0,0 +1,343 @@
+/**
+* @file
+* @brief   Parameters defined at compile time, and the parser filling them without heap allocations
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstring>
+
+#include "pk_util.h"
+#include "color_scheme.h"
+#include "param.h"
+
+namespace paramkit {
+
+    //! The types of the parameters that can be defined at compile time
+    typedef enum {
+        SPARAM_INT = 0,    ///< an integer value (the base is defined by the field StaticParam::base)
+        SPARAM_BOOL = 1,   ///< a boolean value: may be followed by an explicit value, or used as a switch
+        SPARAM_STRING = 2, ///< a string value: the parser stores the pointer to the original argument
+        SPARAM_TYPES_COUNT
+    } t_static_param_type;
+
+    //! A descriptor of a parameter, defined at compile time. Tables of StaticParam are used to build StaticParams.
+    struct StaticParam {
+        const char *argStr; ///< a unique name of the parameter
+        t_static_param_type type; ///< a type of the parameter
+        bool isRequired; ///< a flag indicating if this parameter is required
+        const char *info; ///< a basic information about the the parameter's purpose
+        IntParam::t_int_base base; ///< (SPARAM_INT only) the base in which the number is given
+    };
+
+    namespace util {
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304
+        //! Compares two null-terminated strings at compile time
+        constexpr bool cstr_equal(const char *a, const char *b)
+        {
+            size_t i = 0;
+            for (; a[i] != '\0'; i++) {
+                if (a[i] != b[i]) return false;
+            }
+            return b[i] == '\0';
+        }
+
+        //! Calculates the FNV-1a hash of the null-terminated string at compile time
+        constexpr uint64_t cstr_hash(const char *str)
+        {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (size_t i = 0; str[i] != '\0'; i++) {
+                hash = (hash ^ (unsigned char)str[i]) * 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+        //! The hashes of the names defined in the schema, along with the indexes of the parameters
+        template <size_t N>
+        struct SchemaHashes {
+            uint64_t hash[N];
+            size_t id[N];
+        };
+#else
+        //! Compares two null-terminated strings at compile time
+        constexpr bool cstr_equal(const char *a, const char *b)
+        {
+            return (*a == *b) && (*a == '\0' || cstr_equal(a + 1, b + 1));
+        }
+
+        //! Checks if the parameter with the given name is defined in the schema, in the range [start, end). The range is split in halves, so the depth of the recursion is logarithmic.
+        template <size_t N>
+        constexpr bool schema_has_name(const StaticParam(&schema)[N], const char *name, size_t start, size_t end)
+        {
+            return (end - start <= 1)
+                ? (start < end && cstr_equal(schema[start].argStr, name))
+                : (schema_has_name(schema, name, start, start + (end - start) / 2) || schema_has_name(schema, name, start + (end - start) / 2, end));
+        }
+
+        //! Checks if any of the names defined in the range [start, end) of the schema is also defined in the range [start2, end2)
+        template <size_t N>
+        constexpr bool schema_has_common_names(const StaticParam(&schema)[N], size_t start, size_t end, size_t start2, size_t end2)
+        {
+            return (end - start <= 1)
+                ? (start < end && schema_has_name(schema, schema[start].argStr, start2, end2))
+                : (schema_has_common_names(schema, start, start + (end - start) / 2, start2, end2) || schema_has_common_names(schema, start + (end - start) / 2, end, start2, end2));
+        }
+
+        //! Checks if the names defined in the range [start, end) of the schema are unique
+        template <size_t N>
+        constexpr bool schema_names_unique(const StaticParam(&schema)[N], size_t start, size_t end)
+        {
+            return (end - start <= 1)
+                || (schema_names_unique(schema, start, start + (end - start) / 2) && schema_names_unique(schema, start + (end - start) / 2, end)
+                    && !schema_has_common_names(schema, start, start + (end - start) / 2, start + (end - start) / 2, end));
+        }
+#endif
+    }; //namespace util
+
+    //! Checks (at compile time) if all the names defined in the schema are unique
+    /**
+    With C++14, the hashes of the names are sorted, and only the neighbours are compared, so the check works for the big schemas.
+    Otherwise (C++11), all the pairs of the names are compared, with a logarithmic depth of the recursion: the schemas of more than a few hundred parameters may exceed the limits of the constant evaluation.
+    */
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304
+    template <size_t N>
+    constexpr bool are_names_unique(const StaticParam(&schema)[N])
+    {
+        util::SchemaHashes<N> hashes = {};
+        for (size_t i = 0; i < N; i++) {
+            hashes.hash[i] = util::cstr_hash(schema[i].argStr);
+            hashes.id[i] = i;
+        }
+        // sort by the hashes (Shell sort, with the gaps: 2^k - 1):
+        size_t gap = 1;
+        while (gap < N / 2) gap = gap * 2 + 1;
+        for (; gap > 0; gap /= 2) {
+            for (size_t i = gap; i < N; i++) {
+                const uint64_t hash = hashes.hash[i];
+                const size_t id = hashes.id[i];
+                size_t k = i;
+                for (; k >= gap && hashes.hash[k - gap] > hash; k -= gap) {
+                    hashes.hash[k] = hashes.hash[k - gap];
+                    hashes.id[k] = hashes.id[k - gap];
+                }
+                hashes.hash[k] = hash;
+                hashes.id[k] = id;
+            }
+        }
+        // the equal names have the equal hashes, so they are in the same run:
+        for (size_t start = 0; start < N; ) {
+            size_t end = start + 1;
+            while (end < N && hashes.hash[end] == hashes.hash[start]) end++;
+            for (size_t i = start; i < end; i++) {
+                for (size_t k = i + 1; k < end; k++) {
+                    if (util::cstr_equal(schema[hashes.id[i]].argStr, schema[hashes.id[k]].argStr)) return false;
+                }
+            }
+            start = end;
+        }
+        return true;
+    }
+#else
+    template <size_t N>
+    constexpr bool are_names_unique(const StaticParam(&schema)[N])
+    {
+        return util::schema_names_unique(schema, 0, N);
+    }
+#endif
+
+/**
+Fails the compilation if the given schema (a constexpr table of StaticParam) contains duplicate names. The check is also done automatically by StaticParams.
+*/
+#define PARAMKIT_CHECK_SCHEMA(schema) static_assert(paramkit::are_names_unique(schema), "Duplicate parameter names in: " #schema)
+
+/**
+The type of the StaticParams built from the given schema (a constexpr table of StaticParam, defined at namespace scope).
+*/
+#define PARAMKIT_STATIC_PARAMS(schema) paramkit::StaticParams<sizeof(schema) / sizeof((schema)[0]), schema>
+
+    //! The value of the parameter defined by StaticParam, filled by the parser
+    template <typename T_CHAR>
+    struct StaticValue {
+        bool isSet;
+        uint64_t intVal; ///< used by: SPARAM_INT, SPARAM_BOOL
+        const T_CHAR *strVal; ///< used by: SPARAM_STRING. Points to the parsed argument (not copied).
+    };
+
+    //! The parser of the parameters defined by a compile-time schema (a table of StaticParam). Uses neither virtual functions nor heap allocations.
+    /**
+    The schema is a template argument, so the uniqueness of its names is checked at compile time.
+    Example:
+    \code
+    constexpr paramkit::StaticParam g_schema[] = {
+        { "pdec", paramkit::SPARAM_INT, true, "Sample decimal Integer param", paramkit::IntParam::INT_BASE_DEC },
+        { "pbool", paramkit::SPARAM_BOOL, false, "Sample boolean param" }
+    };
+
+    PARAMKIT_STATIC_PARAMS(g_schema) params;
+    params.parse(argc, argv);
+    \endcode
+    */
+    template <size_t N, const StaticParam(&SCHEMA)[N], typename T_CHAR = char>
+    class StaticParams {
+        static_assert(are_names_unique(SCHEMA), "Duplicate parameter names in the schema");
+
+    public:
+        StaticParams()
+            : schema(SCHEMA)
+        {
+            // sort the indexes by the names (insertion sort: the schema is small, and it is done once):
+            for (size_t i = 0; i < N; i++) {
+                size_t k = i;
+                for (; k > 0 && strcmp(schema[sortedIds[k - 1]].argStr, schema[i].argStr) > 0; k--) {
+                    sortedIds[k] = sortedIds[k - 1];
+                }
+                sortedIds[k] = i;
+            }
+            clear();
+        }
+
+        //! Resets all the values to the uninitialized state
+        void clear()
+        {
+            for (size_t i = 0; i < N; i++) {
+                values[i].isSet = false;
+                values[i].intVal = 0;
+                values[i].strVal = nullptr;
+            }
+        }
+
+        //! Parses the parameters. Prints a warning if an undefined parameter was supplied, or if the value could not be parsed.
+        bool parse(int argc, T_CHAR* argv[])
+        {
+            for (int i = 1; i < argc; i++) {
+                const T_CHAR *name = skip_param_prefix(argv[i]);
+                if (!name) {
+                    printError("Redundant argument: ", argv[i]);
+                    continue;
+                }
+                const size_t id = findParam(name);
+                if (id == N) {
+                    printError("Invalid parameter: ", argv[i]);
+                    return false;
+                }
+                const T_CHAR *paramArg = argv[i];
+                const bool hasArg = (i + 1) < argc && ((schema[id].type != SPARAM_BOOL) || !skip_param_prefix(argv[i + 1]));
+                const T_CHAR *arg = hasArg ? argv[++i] : nullptr;
+                if (!parseValue(id, arg)) {
+                    printError("Parsing the parameter failed: ", paramArg);
+                    return false;
+                }
+            }
+            return hasRequiredFilled();
+        }
+
+        //! Checks if all the required parameters are filled.
+        bool hasRequiredFilled() const
+        {
+            for (size_t i = 0; i < N; i++) {
+                if (schema[i].isRequired && !values[i].isSet) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //! Prints info about all the parameters
+        void printInfo() const
+        {
+            for (size_t i = 0; i < N; i++) {
+                const int color = schema[i].isRequired ? WARNING_COLOR : HILIGHTED_COLOR;
+                print_in_color(color, std::string(1, PARAM_SWITCH1) + schema[i].argStr);
+                std::cout << "\n\t : " << (schema[i].info ? schema[i].info : "") << "\n";
+            }
+        }
+
+        //! Returns the index of the parameter with the given name in the schema, or N if such parameter does not exist. Uses a binary search over the names.
+        size_t findParam(const T_CHAR *name) const
+        {
+            if (!name) return N;
+            size_t start = 0;
+            size_t end = N;
+            while (start < end) {
+                const size_t mid = start + (end - start) / 2;
+                const char *argStr = schema[sortedIds[mid]].argStr;
+                const int cmp = util::tstr_compare(argStr, strlen(argStr), name);
+                if (cmp == 0) {
+                    return sortedIds[mid];
+                }
+                if (cmp < 0) {
+                    start = mid + 1;
+                }
+                else {
+                    end = mid;
+                }
+            }
+            return N;
+        }
+
+        //! Checks if the parameter with the given index is set
+        bool isSet(size_t id) const
+        {
+            return (id < N) ? values[id].isSet : false;
+        }
+
+        //! Gets the integer value of the parameter (SPARAM_INT or SPARAM_BOOL) with the given index. If it is not set, returns the default value.
+        uint64_t getInt(size_t id, uint64_t defaultVal = 0) const
+        {
+            return isSet(id) ? values[id].intVal : defaultVal;
+        }
+
+        //! Gets the string value of the parameter (SPARAM_STRING) with the given index. If it is not set, returns nullptr.
+        const T_CHAR* getString(size_t id) const
+        {
+            return isSet(id) ? values[id].strVal : nullptr;
+        }
+
+    protected:
+
+        bool parseValue(size_t id, const T_CHAR *arg)
+        {
+            StaticValue<T_CHAR> &val = values[id];
+            switch (schema[id].type) {
+            case SPARAM_BOOL:
+                if (!arg) {
+                    val.intVal = 1;
+                }
+                else {
+                    bool boolVal = false;
+                    if (!loadBoolean(arg, boolVal)) return false;
+                    val.intVal = boolVal ? 1 : 0;
+                }
+                break;
+            case SPARAM_STRING:
+                if (!arg || arg[0] == 0) return false;
+                val.strVal = arg;
+                break;
+            case SPARAM_INT:
+                if (!load_number(arg, val.intVal, (t_num_base)schema[id].base)) return false;
+                break;
+            default:
+                return false;
+            }
+            val.isSet = true;
+            return true;
+        }
+
+        void printError(const char *msg, const T_CHAR *arg) const
+        {
+            print_in_color(WARNING_COLOR, msg);
+            for (size_t i = 0; arg[i] != 0; i++) {
+                std::cout << (char)arg[i];
+            }
+            std::cout << "\n";
+        }
+
+        const StaticParam(&schema)[N];
+        size_t sortedIds[N]; ///< the indexes of the parameters, sorted by their names
+        StaticValue<T_CHAR> values[N];
+    };
+
+};
@@ -5,6 +5,9 @@
 
 #pragma once
 #include <string>
+#include <cctype>
+#include <type_traits>
+#include <stdint.h>
 
 namespace paramkit {
 
@@ -17,20 +20,150 @@ namespace paramkit {
             SIM_HIST
         };
 
+        //! The set of characters (case insensitive) occurring in a string, stored as a 256-bit mask
+        struct CharsetSignature {
+            CharsetSignature()
+            {
+                bits[0] = bits[1] = bits[2] = bits[3] = 0;
+            }
+
+            CharsetSignature(const char s[])
+            {
+                bits[0] = bits[1] = bits[2] = bits[3] = 0;
+                for (size_t i = 0; s && s[i] != '\0'; i++) {
+                    const unsigned char c = (unsigned char)tolower((unsigned char)s[i]);
+                    bits[c >> 6] |= (uint64_t)1 << (c & 63);
+                }
+            }
+
+            bool operator==(const CharsetSignature &other) const
+            {
+                return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2] && bits[3] == other.bits[3];
+            }
+
+            bool operator!=(const CharsetSignature &other) const
+            {
+                return !(*this == other);
+            }
+
+            bool operator<(const CharsetSignature &other) const
+            {
+                for (size_t i = 0; i < 4; i++) {
+                    if (bits[i] != other.bits[i]) return bits[i] < other.bits[i];
+                }
+                return false;
+            }
+
+            uint64_t bits[4];
+        };
+
+        //! The narrow copy of the wide string, with each character truncated to 8 bits. The short strings are kept in the local buffer, so converting them doesn't allocate.
+        class NarrowString {
+        public:
+            NarrowString(const wchar_t *str)
+                : ptr(nullptr)
+            {
+                if (!str) return;
+
+                size_t len = 0;
+                while (str[len] != 0) len++;
+                char *buf = local;
+                if (len >= LOCAL_MAX) {
+                    heapBuf.resize(len + 1);
+                    buf = &heapBuf[0];
+                }
+                for (size_t i = 0; i < len; i++) {
+                    buf[i] = (char)str[i];
+                }
+                buf[len] = '\0';
+                ptr = buf;
+            }
+
+            //! Returns the converted string, or nullptr if the converted one was nullptr
+            const char* c_str() const { return ptr; }
+
+        protected:
+            NarrowString(const NarrowString &); // copying is not allowed: the pointer may refer to the local buffer
+            NarrowString& operator=(const NarrowString &);
+
+            static const size_t LOCAL_MAX = 128;
+            char local[LOCAL_MAX];
+            std::string heapBuf;
+            const char *ptr;
+        };
+
         std::string to_lowercase(std::string);
 
         bool is_cstr_equal(char const *a, char const *b, const size_t max_len, bool ignoreCase = true);
         bool strequals(const std::string& a, const std::string& b, bool ignoreCase = true);
 
+        //! Compares the null-terminated string of any character type with the given ASCII string. Does not make any copies.
+        template <typename T_CHAR>
+        bool is_tstr_equal(const T_CHAR *a, const char *b, bool ignoreCase = true)
+        {
+            if (!a || !b) return false;
+            size_t i = 0;
+            for (; a[i] != 0 && b[i] != '\0'; ++i) {
+                if ((unsigned long)a[i] > 0x7f) return false; // non-ASCII
+                const char c = (char)a[i];
+                if (ignoreCase ? (tolower(c) != tolower(b[i])) : (c != b[i])) {
+                    return false;
+                }
+            }
+            return a[i] == 0 && b[i] == '\0';
+        }
+
+        //! Compares (lexicographically) the string of the given length with the null-terminated string of any character type. Returns a value <0, 0, or >0, like std::string::compare.
+        /**
+        If ignoreCase is set, the ASCII letters are compared as lowercase.
+        */
+        template <typename T_CHAR>
+        int tstr_compare(const char *a, size_t len, const T_CHAR *b, bool ignoreCase = false)
+        {
+            for (size_t i = 0; i < len; ++i) {
+                // both sides are compared as unsigned, so the non-ASCII chars are not sign-extended:
+                unsigned long c1 = (unsigned char)a[i];
+                unsigned long c2 = (unsigned long)(typename std::make_unsigned<T_CHAR>::type)b[i];
+                if (c2 == 0) return 1; // b is shorter
+                if (ignoreCase) {
+                    if (c1 >= 'A' && c1 <= 'Z') c1 += ('a' - 'A');
+                    if (c2 >= 'A' && c2 <= 'Z') c2 += ('a' - 'A');
+                }
+                if (c1 != c2) return (c1 < c2) ? -1 : 1;
+            }
+            return (b[len] == 0) ? 0 : -1;
+        }
+
+        template <typename T_CHAR>
+        int tstr_compare(const std::string &a, const T_CHAR *b, bool ignoreCase = false)
+        {
+            return tstr_compare(a.c_str(), a.length(), b, ignoreCase);
+        }
+
         // Calculate Levenshtein distance of two strings
         size_t levenshtein_distance(const char s1[], const char s2[]);
 
-        // Check a similarity in strings histograms
+        // Calculate Levenshtein distance of two strings, but stop as soon as it is known to exceed max_dist. In such case, returns max_dist + 1.
+        size_t levenshtein_distance(const char s1[], const char s2[], size_t max_dist);
+
+        // Check a similarity in strings histograms: if both strings consist of the same set of characters
         bool has_similar_histogram(const char s1[], const char s2[]);
 
+        // Check a similarity in strings histograms, using the precalculated sets of characters
+        inline bool has_similar_histogram(const CharsetSignature &s1, const CharsetSignature &s2)
+        {
+            return s1 == s2;
+        }
+
         stringsim_type has_keyword(const std::string param, const std::string filter);
 
         stringsim_type is_string_similar(const std::string &param, const std::string &filter);
+
+        // A variant of is_string_similar using the precalculated sets of characters of both strings
+        stringsim_type is_string_similar(const std::string &param, const CharsetSignature &paramCharset, const std::string &filter, const CharsetSignature &filterCharset);
+
+        // Decode the UTF-8 text, appending it to the wide string: in UTF-16 if the wchar_t has 16 bits (Windows), or in UTF-32 otherwise. Each invalid byte is replaced by U+FFFD.
+        void append_utf8(const char *str, size_t len, std::wstring &out);
     }; //namespace util
 
 }; // namespace paramkit
@@ -5,8 +5,6 @@
 
 #pragma once
 
-#include <iostream>
-#include <windows.h>
 
 #define BLACK 0
 #define DARK_BLUE 1
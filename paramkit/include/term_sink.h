@@ -0,0 +1,63 @@
+/**
+* @file
+* @brief   The output terminal: detects its capabilities once, and prints the colored text in the most efficient way it supports
+*/
+
+#pragma once
+
+#include <string>
+
+#include "colored_text.h"
+
+namespace paramkit {
+
+    //! The ways in which the colors can be printed on the output terminal
+    typedef enum {
+        TERM_NO_COLORS = 0, ///< the output is not a terminal (i.e. redirected to a file or a pipe): the colors are skipped
+        TERM_ANSI = 1, ///< the terminal supports ANSI escape sequences: the colors are embedded in the text
+        TERM_WIN_CONSOLE = 2, ///< the legacy Windows console: the colors are set by changing the console attributes
+        TERM_MODES_COUNT
+    } t_term_mode;
+
+    //! The sink for the output printed on the terminal (stdout)
+    class TermSink {
+    public:
+        //! Returns the sink of the standard output. The capabilities of the terminal are detected at the first use.
+        static TermSink& stdoutSink();
+
+        t_term_mode getMode() const
+        {
+            return mode;
+        }
+
+        //! Overrides the detected mode, i.e. to disable the colors
+        void setMode(t_term_mode _mode)
+        {
+            mode = _mode;
+        }
+
+        //! Prints the text in the given color
+        void print(int color, const std::string &text);
+
+        //! Prints the whole text with its colored ranges
+        void print(const ColoredText &text);
+
+        //! Restores the console mode that was changed at the detection (Windows only)
+        ~TermSink();
+
+    protected:
+        TermSink();
+
+        //! Appends the ANSI escape sequence setting the color (defined in the format of term_colors.h)
+        static void appendAnsiColor(std::string &out, int color);
+
+        void printWithAttributes(const ColoredText &text);
+
+        t_term_mode mode;
+        void *consoleHandle; ///< TERM_WIN_CONSOLE only: the handle of the console
+        int defaultColor; ///< TERM_WIN_CONSOLE only: the console attributes at the time of the detection
+        unsigned long originalConsoleMode; ///< Windows only: the console mode before enabling the escape sequences
+        bool isConsoleModeChanged; ///< Windows only: the original console mode has to be restored
+    };
+
+};
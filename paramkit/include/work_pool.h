@@ -0,0 +1,79 @@
+/**
+* @file
+* @brief   The pool of threads processing a batch of independent items, balanced by work stealing
+*/
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stddef.h>
+
+namespace paramkit {
+
+    namespace util {
+
+        //! Processes batches of items on multiple threads.
+        /**
+        The items are divided into chunks, which are distributed evenly among the threads. Each thread processes its own chunks,
+        and when it runs out of them, steals the chunks from the others, so that the threads are kept busy till the end of the batch.
+        The calling thread takes part in the processing. The worker threads are started by the first batch that needs them,
+        and they wait for the next batches till the pool is destroyed.
+        */
+        class WorkStealingPool {
+        public:
+            WorkStealingPool()
+                : stopping(false), batchId(0), batchThreads(0), busyWorkers(0), batchJob(nullptr)
+            {
+            }
+
+            //! Stops and joins the worker threads
+            ~WorkStealingPool();
+
+            //! Returns the number of the threads used by default: the number of the hardware threads
+            static size_t defaultThreadsCount();
+
+            //! Runs the task for each item of the batch, and waits until all of them are processed
+            /**
+            If the task throws an exception, the remaining chunks are skipped, and the first exception is rethrown on the calling thread.
+            If the threads cannot be started, the batch is processed by the ones that are available (in the worst case: by the calling thread alone).
+            The batches submitted from multiple threads are processed one after another.
+            \param itemsCount : the number of the items in the batch
+            \param task : the function processing a single item, given by its index. It is called concurrently, so it must not modify any shared state.
+            \param threadsCount : the maximal number of the threads to be used (including the calling thread), or 0 for the default
+            \param chunkSize : the number of the items in a chunk (the unit of stealing), or 0 to select it automatically
+            */
+            void run(size_t itemsCount, const std::function<void(size_t)> &task, size_t threadsCount = 0, size_t chunkSize = 0);
+
+            //! Returns the number of the worker threads that were started (excluding the calling thread)
+            size_t workersCount() const
+            {
+                return workers.size();
+            }
+
+        protected:
+            //! Starts the workers, so that the batch can be processed by the given number of the threads. Returns the number of the threads that are available.
+            size_t startWorkers(size_t threadsCount);
+
+            //! The loop of the worker thread: processes the batches following the one with the given id, till the pool is stopped
+            void workerLoop(size_t workerId, size_t seenBatchId);
+
+            std::vector<std::thread> workers;
+            std::mutex runMutex; ///< serializes the batches
+
+            std::mutex mutex; ///< guards the state of the current batch
+            std::condition_variable batchReady;
+            std::condition_variable batchDone;
+            bool stopping;
+            size_t batchId; ///< incremented for each batch that is handed to the workers
+            size_t batchThreads; ///< the number of the threads processing the current batch: the workers with the higher ids skip it
+            size_t busyWorkers; ///< the number of the workers that didn't finish the current batch yet
+            const std::function<void(size_t)> *batchJob; ///< the job of the current batch, called with the id of the thread
+        };
+
+    }; //namespace util
+
+}; //namespace paramkit
@@ -0,0 +1,164 @@
+#include "mapped_file.h"
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+    //! Maps the opened file, and closes its handle (the mapping keeps the file open). Returns false if the file could not be mapped.
+    bool map_file(HANDLE file, const char *&buf, size_t &bufSize, void *&mapping)
+    {
+        LARGE_INTEGER fileSize = { 0 };
+        if (!GetFileSizeEx(file, &fileSize) || (uint64_t)fileSize.QuadPart > (size_t)(-1)) {
+            CloseHandle(file);
+            return false;
+        }
+        if (fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return true;
+        }
+        HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if (!fileMapping) {
+            return false;
+        }
+        const void *view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(fileMapping);
+            return false;
+        }
+        mapping = fileMapping;
+        buf = static_cast<const char*>(view);
+        bufSize = (size_t)fileSize.QuadPart;
+        return true;
+    }
+#else
+    //! Maps the opened file, and closes its descriptor (the mapping keeps the file open). Returns false if the file could not be mapped.
+    bool map_file(int fd, const char *&buf, size_t &bufSize)
+    {
+        struct stat info;
+        // the size must fit in the address space (i.e. in a 32-bit build):
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size < 0 || (uint64_t)info.st_size > (uint64_t)((size_t)(-1))) {
+            ::close(fd);
+            return false;
+        }
+        if (info.st_size == 0) {
+            ::close(fd);
+            return true;
+        }
+        void *view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            return false;
+        }
+        // the file is read once, from the start to the end:
+        madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+        buf = static_cast<const char*>(view);
+        bufSize = (size_t)info.st_size;
+        return true;
+    }
+
+    //! Encodes the wide string in UTF-8: the encoding of the file names on the POSIX systems. Returns false if it contains an invalid code point.
+    bool to_utf8(const std::wstring &str, std::string &out)
+    {
+        for (size_t i = 0; i < str.length(); i++) {
+            uint32_t cp = (uint32_t)str[i];
+            if (sizeof(wchar_t) == 2 && cp >= 0xD800 && cp <= 0xDBFF && i + 1 < str.length()) {
+                const uint32_t low = (uint32_t)str[i + 1];
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    i++;
+                }
+            }
+            if (cp >= 0xD800 && cp <= 0xDFFF) return false; // unpaired surrogate
+            if (cp < 0x80) {
+                out.push_back((char)cp);
+            }
+            else if (cp < 0x800) {
+                out.push_back((char)(0xC0 | (cp >> 6)));
+                out.push_back((char)(0x80 | (cp & 0x3F)));
+            }
+            else if (cp < 0x10000) {
+                out.push_back((char)(0xE0 | (cp >> 12)));
+                out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back((char)(0x80 | (cp & 0x3F)));
+            }
+            else if (cp <= 0x10FFFF) {
+                out.push_back((char)(0xF0 | (cp >> 18)));
+                out.push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+                out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back((char)(0x80 | (cp & 0x3F)));
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+#endif
+
+}; // anonymous namespace
+
+bool paramkit::util::MappedFile::open(const std::string &path)
+{
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    opened = map_file(file, buf, bufSize, mapping);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    opened = map_file(fd, buf, bufSize);
+#endif
+    return opened;
+}
+
+bool paramkit::util::MappedFile::open(const std::wstring &path)
+{
+#ifdef _WIN32
+    close();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    opened = map_file(file, buf, bufSize, mapping);
+    return opened;
+#else
+    std::string utf8Path;
+    if (!to_utf8(path, utf8Path)) {
+        close();
+        return false;
+    }
+    return open(utf8Path);
+#endif
+}
+
+void paramkit::util::MappedFile::close()
+{
+    if (buf) {
+#ifdef _WIN32
+        UnmapViewOfFile(buf);
+        CloseHandle(mapping);
+#else
+        munmap(const_cast<char*>(buf), bufSize);
+#endif
+    }
+    buf = nullptr;
+    bufSize = 0;
+    mapping = nullptr;
+    opened = false;
+}
@@ -0,0 +1,84 @@
+#include "membership_set.h"
+
+#include <algorithm>
+
+void paramkit::util::MembershipSet::clear()
+{
+    kind = SET_EMPTY;
+    minVal = 0;
+    maxVal = 0;
+    valuesCount = 0;
+    words.clear();
+    hashShift = 0;
+    hasZero = false;
+}
+
+void paramkit::util::MembershipSet::build(const uint64_t *values, size_t count)
+{
+    clear();
+    if (!values || !count) return;
+
+    std::vector<uint64_t> sorted(values, values + count);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    valuesCount = sorted.size();
+    minVal = sorted.front();
+    maxVal = sorted.back();
+
+    const uint64_t range = maxVal - minVal;
+    // the bitmap is used if it is not bigger than the sorted values would be:
+    const uint64_t bitmapWords = (range >> 6) + 1;
+    if (range < BITMAP_MAX_RANGE && bitmapWords <= valuesCount) {
+        buildBitmap(sorted);
+        return;
+    }
+    if (valuesCount <= SORTED_MAX) {
+        kind = SET_SORTED;
+        words.swap(sorted);
+        return;
+    }
+    buildHashed(sorted);
+}
+
+void paramkit::util::MembershipSet::buildBitmap(const std::vector<uint64_t> &sorted)
+{
+    kind = SET_BITMAP;
+    const uint64_t range = maxVal - minVal;
+    words.assign((size_t)(range >> 6) + 1, 0);
+
+    std::vector<uint64_t>::const_iterator itr;
+    for (itr = sorted.begin(); itr != sorted.end(); ++itr) {
+        const uint64_t bit = *itr - minVal;
+        words[(size_t)(bit >> 6)] |= ((uint64_t)1 << (bit & 63));
+    }
+}
+
+void paramkit::util::MembershipSet::buildHashed(const std::vector<uint64_t> &sorted)
+{
+    kind = SET_HASHED;
+    // the table is filled at most in half, so that the probing sequences stay short:
+    size_t capacity = 1;
+    unsigned int bits = 0;
+    while (capacity < sorted.size() * 2) {
+        capacity <<= 1;
+        bits++;
+    }
+    hashShift = 64 - bits;
+    words.assign(capacity, 0);
+
+    const size_t mask = capacity - 1;
+    std::vector<uint64_t>::const_iterator itr;
+    for (itr = sorted.begin(); itr != sorted.end(); ++itr) {
+        const uint64_t val = *itr;
+        if (val == 0) {
+            hasZero = true;
+            continue;
+        }
+        size_t pos = hashSlot(val);
+        while (words[pos] != 0) {
+            pos = (pos + 1) & mask;
+        }
+        words[pos] = val;
+    }
+}
@@ -1,43 +1,27 @@
 #include "pk_util.h"
 #include "strings_util.h"
+#include "term_sink.h"
+
+#include <cstring>
+#include <climits>
 
 bool paramkit::is_hex(const char *buf, size_t len)
 {
-    if (!buf || len == 0) return false;
-    for (size_t i = 0; i < len; i++) {
-        if (buf[i] >= '0' && buf[i] <= '9') continue;
-        if (buf[i] >= 'A' && buf[i] <= 'F') continue;
-        if (buf[i] >= 'a' && buf[i] <= 'f') continue;
-        return false;
-    }
-    return true;
+    return (scan_digits(buf, len) & DIGITS_HEX) != 0;
 }
 
 bool paramkit::is_dec(const char *buf, size_t len)
 {
-    if (!buf || len == 0) return false;
-    for (size_t i = 0; i < len; i++) {
-        if (buf[i] >= '0' && buf[i] <= '9') continue;
-        return false;
-    }
-    return true;
+    return (scan_digits(buf, len) & DIGITS_DEC) != 0;
 }
 
 bool paramkit::is_hex_with_prefix(const char *my_buf)
 {
     if (!my_buf) return false;
 
-    const char hex_pattern[] = "0x";
-    size_t hex_pattern_len = strlen(hex_pattern);
-
-    const size_t len = strlen(my_buf);
-    if (len == 0) return false;
-
-    if (len > hex_pattern_len) {
-        if (util::is_cstr_equal(my_buf, hex_pattern, hex_pattern_len)) {
-            if (!is_hex(my_buf + hex_pattern_len, len - hex_pattern_len)) return false;
-            return true;
-        }
+    t_num_base base = NUM_BASE_ANY;
+    if (detect_number_base(my_buf, strlen(my_buf), base)) {
+        return base == NUM_BASE_HEX;
     }
     return false;
 }
@@ -46,62 +30,27 @@ bool paramkit::is_number(const char* my_buf)
 {
     if (!my_buf) return false;
 
-    const size_t len = strlen(my_buf);
-    if (is_hex_with_prefix(my_buf)) return true;
-    if (is_dec(my_buf, len)) return true;
-    return false;
+    t_num_base base = NUM_BASE_ANY;
+    return detect_number_base(my_buf, strlen(my_buf), base);
 }
 
 long paramkit::get_number(const char *my_buf)
 {
-    if (!my_buf) return false;
-
-    const char hex_pattern[] = "0x";
-    size_t hex_pattern_len = strlen(hex_pattern);
-
-    const size_t len = strlen(my_buf);
-    if (len == 0) return 0;
-
-    long out = 0;
-    const size_t min_length = 1; //tolerate number with at least 1 character
-    if (len > hex_pattern_len) {
-        if (util::is_cstr_equal(my_buf, hex_pattern, hex_pattern_len)) {
-            if (!is_hex(my_buf + hex_pattern_len, min_length)) return 0;
-
-            std::stringstream ss;
-            ss << std::hex << my_buf;
-            ss >> out;
-            return out;
-        }
+    uint64_t out = 0;
+    if (!load_number(my_buf, out, NUM_BASE_ANY) || out > (uint64_t)LONG_MAX) {
+        return 0; // on LLP64 (Windows), long has only 32 bits
     }
-    if (!is_dec(my_buf, min_length)) return 0;
-
-    std::stringstream ss;
-    ss << std::dec << my_buf;
-    ss >> out;
-    return out;
-}
-
-bool paramkit::get_console_color(HANDLE hConsole, int& color) {
-    CONSOLE_SCREEN_BUFFER_INFO info;
-    if (!GetConsoleScreenBufferInfo(hConsole, &info))
-        return false;
-    color = info.wAttributes;
-    return true;
+    return (long)out;
 }
 
 void paramkit::print_in_color(int color, const std::string &text)
 {
-    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    int prev = 7;
-    get_console_color(hConsole, prev); // get the previous color
-
-    FlushConsoleInputBuffer(hConsole);
-    SetConsoleTextAttribute(hConsole, color); // back to default color
-    std::cout << text;
-    FlushConsoleInputBuffer(hConsole);
+    TermSink::stdoutSink().print(color, text);
+}
 
-    SetConsoleTextAttribute(hConsole, prev); // back to previous color
+void paramkit::print_colored(const ColoredText &colored)
+{
+    TermSink::stdoutSink().print(colored);
 }
 
 namespace paramkit {
@@ -0,0 +1,37 @@
+#include "pooled_string.h"
+
+#include <new>
+
+namespace {
+
+    std::atomic<size_t> g_sharedTextsCount(0);
+
+}; // anonymous namespace
+
+paramkit::util::SharedText* paramkit::util::make_shared_text(const char *str, size_t len)
+{
+    // the header and the characters are allocated in a single block:
+    void *block = ::operator new(sizeof(SharedText) + len + 1);
+    SharedText *shared = new (block) SharedText();
+    shared->refs.store(1, std::memory_order_relaxed);
+    shared->len = len;
+    char *chars = reinterpret_cast<char*>(shared + 1);
+    memcpy(chars, str, len);
+    chars[len] = '\0';
+    g_sharedTextsCount++;
+    return shared;
+}
+
+void paramkit::util::release_shared_text(SharedText *shared)
+{
+    if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    shared->~SharedText();
+    ::operator delete(shared);
+    g_sharedTextsCount--;
+}
+
+size_t paramkit::util::shared_texts_count()
+{
+    return g_sharedTextsCount.load();
+}
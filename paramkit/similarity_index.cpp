@@ -0,0 +1,354 @@
+#include "similarity_index.h"
+
+#include <algorithm>
+#include <set>
+#include <cctype>
+#include <cstring>
+#include <iterator>
+
+namespace paramkit {
+    namespace util {
+
+        bool is_more_similar(const SimilarName &a, const SimilarName &b)
+        {
+            if (a.simType != b.simType) return a.simType < b.simType;
+            if (a.distance != b.distance) return a.distance < b.distance;
+            return a.name < b.name;
+        }
+
+    }; //namespace util
+}; //namespace paramkit
+
+void paramkit::util::SimilarityIndex::makeTrigrams(const std::string &lowStr, std::vector<t_trigram> &trigrams)
+{
+    const size_t TRIGRAM_LEN = 3;
+    if (lowStr.length() < TRIGRAM_LEN) return;
+
+    for (size_t i = 0; i + TRIGRAM_LEN <= lowStr.length(); i++) {
+        const t_trigram trigram = ((t_trigram)(unsigned char)lowStr[i] << 16)
+            | ((t_trigram)(unsigned char)lowStr[i + 1] << 8)
+            | (t_trigram)(unsigned char)lowStr[i + 2];
+        trigrams.push_back(trigram);
+    }
+    // keep the unique ones:
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+void paramkit::util::SimilarityIndex::makeShortGrams(const std::string &lowStr, std::vector<t_trigram> &grams)
+{
+    // the codes don't collide with each other, nor with the trigrams, since the strings don't contain NUL characters
+    for (size_t i = 0; i < lowStr.length(); i++) {
+        grams.push_back((t_trigram)(unsigned char)lowStr[i]);
+        if (i + 1 < lowStr.length()) {
+            grams.push_back(((t_trigram)(unsigned char)lowStr[i] << 8) | (t_trigram)(unsigned char)lowStr[i + 1]);
+        }
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+bool paramkit::util::SimilarityIndex::insert(const std::string &name)
+{
+    if (name.empty()) return false;
+    if (nameToId.find(name) != nameToId.end()) return false;
+
+    const size_t id = names.size();
+    names.push_back(name);
+    nameToId[name] = id;
+    if (name.length() > maxNameLen) {
+        maxNameLen = name.length();
+    }
+
+    // the BK-tree:
+    BkNode node;
+    node.nameId = id;
+    if (bkTree.empty()) {
+        bkTree.push_back(node);
+    }
+    else {
+        size_t current = 0;
+        while (true) {
+            const size_t dist = levenshtein_distance(names[bkTree[current].nameId].c_str(), name.c_str());
+            std::map<size_t, size_t>::iterator itr = bkTree[current].children.find(dist);
+            if (itr == bkTree[current].children.end()) {
+                bkTree[current].children[dist] = bkTree.size();
+                bkTree.push_back(node);
+                break;
+            }
+            current = itr->second;
+        }
+    }
+
+    // the substrings:
+    const std::string lowName = to_lowercase(name);
+    std::vector<t_trigram> trigrams;
+    makeTrigrams(lowName, trigrams);
+    idToTrigramsCount.push_back(trigrams.size());
+    if (trigrams.empty()) {
+        shortIds.push_back(id);
+    }
+    for (std::vector<t_trigram>::iterator itr = trigrams.begin(); itr != trigrams.end(); ++itr) {
+        trigramToIds[*itr].push_back(id);
+    }
+    std::vector<t_trigram> shortGrams;
+    makeShortGrams(lowName, shortGrams);
+    for (std::vector<t_trigram>::iterator itr = shortGrams.begin(); itr != shortGrams.end(); ++itr) {
+        shortGramToIds[*itr].push_back(id);
+    }
+
+    // the sets of characters:
+    const CharsetSignature charset(name.c_str());
+    idToCharset.push_back(charset);
+    charsetToIds[charset].push_back(id);
+    return true;
+}
+
+void paramkit::util::SimilarityIndex::clear()
+{
+    names.clear();
+    nameToId.clear();
+    bkTree.clear();
+    trigramToIds.clear();
+    idToTrigramsCount.clear();
+    shortIds.clear();
+    shortGramToIds.clear();
+    maxNameLen = 0;
+    idToCharset.clear();
+    charsetToIds.clear();
+}
+
+void paramkit::util::SimilarityIndex::collectByDistance(const std::string &filter, size_t radius, std::set<size_t> &candidates) const
+{
+    if (bkTree.empty()) return;
+
+    // the distances between the names are not bigger than the longest name, so the subtrees are pruned exactly also if the bigger distances are not calculated:
+    const size_t maxDist = maxNameLen + radius;
+    std::vector<size_t> toVisit;
+    toVisit.push_back(0);
+    while (!toVisit.empty()) {
+        const BkNode &node = bkTree[toVisit.back()];
+        toVisit.pop_back();
+
+        const size_t dist = levenshtein_distance(names[node.nameId].c_str(), filter.c_str(), maxDist);
+        if (dist <= radius) {
+            candidates.insert(node.nameId);
+        }
+        // by the triangle inequality, the matches may be only in the subtrees within: [dist - radius, dist + radius]
+        const size_t minDist = (dist > radius) ? (dist - radius) : 0;
+        std::map<size_t, size_t>::const_iterator itr = node.children.lower_bound(minDist);
+        for (; itr != node.children.end() && itr->first <= dist + radius; ++itr) {
+            toVisit.push_back(itr->second);
+        }
+    }
+}
+
+void paramkit::util::SimilarityIndex::collectBySubstring(const std::string &lowFilter, std::set<size_t> &candidates) const
+{
+    std::vector<t_trigram> trigrams;
+    makeTrigrams(lowFilter, trigrams);
+    if (trigrams.empty()) {
+        // the filter is too short to use the trigrams: it is one of the short substrings
+        std::map<t_trigram, std::vector<size_t> >::const_iterator found = shortGramToIds.end();
+        if (lowFilter.length() == 1) {
+            found = shortGramToIds.find((t_trigram)(unsigned char)lowFilter[0]);
+        }
+        else if (lowFilter.length() == 2) {
+            found = shortGramToIds.find(((t_trigram)(unsigned char)lowFilter[0] << 8) | (t_trigram)(unsigned char)lowFilter[1]);
+        }
+        if (found != shortGramToIds.end()) {
+            candidates.insert(found->second.begin(), found->second.end());
+        }
+        candidates.insert(shortIds.begin(), shortIds.end());
+        return;
+    }
+    // count how many trigrams of the filter each name contains:
+    std::map<size_t, size_t> idToCount;
+    for (std::vector<t_trigram>::iterator itr = trigrams.begin(); itr != trigrams.end(); ++itr) {
+        std::map<t_trigram, std::vector<size_t> >::const_iterator found = trigramToIds.find(*itr);
+        if (found == trigramToIds.end()) continue;
+
+        const std::vector<size_t> &ids = found->second;
+        for (std::vector<size_t>::const_iterator idItr = ids.begin(); idItr != ids.end(); ++idItr) {
+            idToCount[*idItr]++;
+        }
+    }
+    for (std::map<size_t, size_t>::iterator itr = idToCount.begin(); itr != idToCount.end(); ++itr) {
+        const size_t id = itr->first;
+        // the filter may be a substring of the name, or the name a substring of the filter:
+        if (itr->second == trigrams.size() || itr->second == idToTrigramsCount[id]) {
+            candidates.insert(id);
+        }
+    }
+    // the names without trigrams may be substrings of the filter:
+    candidates.insert(shortIds.begin(), shortIds.end());
+}
+
+void paramkit::util::SimilarityIndex::collectByCharset(const CharsetSignature &filterCharset, std::set<size_t> &candidates) const
+{
+    std::map<CharsetSignature, std::vector<size_t> >::const_iterator found = charsetToIds.find(filterCharset);
+    if (found != charsetToIds.end()) {
+        candidates.insert(found->second.begin(), found->second.end());
+    }
+}
+
+size_t paramkit::util::SimilarityIndex::find(const std::string &filter, std::vector<SimilarName> &found, size_t maxCount) const
+{
+    if (filter.empty() || names.empty()) return 0;
+
+    const std::string lowFilter = to_lowercase(filter);
+    const CharsetSignature filterCharset(filter.c_str());
+    std::set<size_t> candidates;
+    collectBySubstring(lowFilter, candidates);
+    collectByCharset(filterCharset, candidates);
+    // is_string_similar accepts the distances smaller than the filter length, and not bigger than a half of the name length (or 1):
+    if (filter.length() > 1) {
+        const size_t maxNameDist = (maxNameLen / 2) > 1 ? (maxNameLen / 2) : 1;
+        const size_t radius = (filter.length() - 1) < maxNameDist ? (filter.length() - 1) : maxNameDist;
+        collectByDistance(filter, radius, candidates);
+    }
+
+    // the distance is not bigger than the length of the longer string:
+    const size_t maxRankDist = (filter.length() > maxNameLen) ? filter.length() : maxNameLen;
+    std::vector<SimilarName> results;
+    for (std::set<size_t>::iterator itr = candidates.begin(); itr != candidates.end(); ++itr) {
+        const std::string &name = names[*itr];
+        const stringsim_type simType = is_string_similar(name, idToCharset[*itr], filter, filterCharset);
+        if (simType == SIM_NONE) continue;
+
+        SimilarName result;
+        result.name = name;
+        result.simType = simType;
+        result.distance = levenshtein_distance(name.c_str(), filter.c_str(), maxRankDist);
+        results.push_back(result);
+    }
+    std::sort(results.begin(), results.end(), is_more_similar);
+    if (maxCount && results.size() > maxCount) {
+        results.resize(maxCount);
+    }
+    found.insert(found.end(), results.begin(), results.end());
+    return results.size();
+}
+
+//---
+
+size_t paramkit::util::KeywordIndex::splitWords(const char *text, size_t len, std::vector<std::string> &words)
+{
+    size_t count = 0;
+    size_t start = 0;
+    while (start < len) {
+        while (start < len && !(isalnum((unsigned char)text[start]) || text[start] == '_')) start++;
+        size_t end = start;
+        while (end < len && (isalnum((unsigned char)text[end]) || text[end] == '_')) end++;
+        if (end > start) {
+            words.push_back(to_lowercase(std::string(text + start, end - start)));
+            count++;
+        }
+        start = end;
+    }
+    return count;
+}
+
+void paramkit::util::KeywordIndex::addText(const char *text, size_t len, size_t textId)
+{
+    if (textIds.empty() || textIds.back() != textId) {
+        textOffsets.push_back(words.length());
+        textIds.push_back(textId);
+    }
+    size_t start = 0;
+    while (start < len) {
+        while (start < len && !(isalnum((unsigned char)text[start]) || text[start] == '_')) start++;
+        size_t end = start;
+        while (end < len && (isalnum((unsigned char)text[end]) || text[end] == '_')) end++;
+        if (end == start) break;
+
+        const size_t wordOffset = words.length();
+        if (wordOffset + (end - start) >= UINT32_MAX) break; // the offsets must fit in 32 bits
+        for (size_t i = start; i < end; i++) {
+            suffixes.push_back((uint32_t)words.length());
+            words.push_back((char)tolower((unsigned char)text[i]));
+        }
+        words.push_back('\0');
+        start = end;
+    }
+    isBuilt = false;
+}
+
+namespace {
+
+    //! Orders the suffixes of the words, given as the offsets in the buffer of the NUL-terminated words
+    struct SuffixCompare {
+        SuffixCompare(const char *_words)
+            : words(_words)
+        {
+        }
+
+        bool operator()(uint32_t a, uint32_t b) const
+        {
+            return strcmp(words + a, words + b) < 0;
+        }
+
+        bool operator()(uint32_t a, const std::string &key) const
+        {
+            return strcmp(words + a, key.c_str()) < 0;
+        }
+
+        const char *words;
+    };
+
+}; // anonymous namespace
+
+void paramkit::util::KeywordIndex::build()
+{
+    if (isBuilt) return;
+    std::sort(suffixes.begin(), suffixes.end(), SuffixCompare(words.c_str()));
+    isBuilt = true;
+}
+
+void paramkit::util::KeywordIndex::clear()
+{
+    words.clear();
+    suffixes.clear();
+    textOffsets.clear();
+    textIds.clear();
+    isBuilt = true;
+}
+
+size_t paramkit::util::KeywordIndex::findTextId(size_t offset) const
+{
+    std::vector<size_t>::const_iterator found = std::upper_bound(textOffsets.begin(), textOffsets.end(), offset);
+    return textIds[(found - textOffsets.begin()) - 1];
+}
+
+size_t paramkit::util::KeywordIndex::findTexts(const std::string &keyword, std::set<size_t> &textIds) const
+{
+    if (!isBuilt) return 0;
+
+    std::vector<std::string> keywordWords;
+    if (!splitWords(keyword, keywordWords)) {
+        return 0;
+    }
+    const char *buf = words.c_str();
+    std::set<size_t> found;
+    for (std::vector<std::string>::iterator itr = keywordWords.begin(); itr != keywordWords.end(); ++itr) {
+        // the word occurs in the texts having any of the suffixes that start from it: they are consecutive in the sorted array
+        std::set<size_t> withWord;
+        std::vector<uint32_t>::const_iterator sItr = std::lower_bound(suffixes.begin(), suffixes.end(), *itr, SuffixCompare(buf));
+        for (; sItr != suffixes.end() && strncmp(buf + *sItr, itr->c_str(), itr->length()) == 0; ++sItr) {
+            withWord.insert(findTextId(*sItr));
+        }
+        if (itr == keywordWords.begin()) {
+            found.swap(withWord);
+        }
+        else {
+            std::set<size_t> common;
+            std::set_intersection(found.begin(), found.end(), withWord.begin(), withWord.end(), std::inserter(common, common.end()));
+            found.swap(common);
+        }
+        if (found.empty()) {
+            return 0;
+        }
+    }
+    textIds.insert(found.begin(), found.end());
+    return found.size();
+}
@@ -1,7 +1,9 @@
 #include "strings_util.h"
 
 #include <algorithm>
+#include <vector>
 #include <cstring>
+#include <stdint.h>
 
 #define MIN(x,y) ((x) < (y) ? (x) : (y))
 
@@ -47,75 +49,109 @@ bool paramkit::util::strequals(const std::string& a, const std::string& b, bool
     return true;
 }
 
-size_t paramkit::util::levenshtein_distance(const char s1[], const char s2[])
-{
-    const size_t MAX_LEN = 100;
-    const size_t len1 = strlen(s1);
-    const size_t len2 = strlen(s2);
+namespace paramkit {
+    namespace util {
 
-    if (len1 >= MAX_LEN || len2 >= MAX_LEN) return(-1);
+        // Levenshtein distance: the bit-parallel algorithm of Myers (in the formulation of Hyyrö). The pattern must be no longer than 64 characters.
+        size_t levenshtein_bitparallel(const char *pattern, size_t pLen, const char *text, size_t tLen, size_t max_dist)
+        {
+            uint64_t peq[256] = { 0 }; // positions of each character in the pattern
+            for (size_t i = 0; i < pLen; i++) {
+                peq[(unsigned char)pattern[i]] |= (uint64_t)1 << i;
+            }
+            const uint64_t lastBit = (uint64_t)1 << (pLen - 1);
+            uint64_t pv = ~(uint64_t)0;
+            uint64_t mv = 0;
+            size_t score = pLen;
+
+            for (size_t j = 0; j < tLen; j++) {
+                const uint64_t eq = peq[(unsigned char)text[j]];
+                const uint64_t xv = eq | mv;
+                const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                uint64_t ph = mv | ~(xh | pv);
+                uint64_t mh = pv & xh;
+                if (ph & lastBit) {
+                    score++;
+                }
+                else if (mh & lastBit) {
+                    score--;
+                }
+                // the score changes by at most 1 per the remaining character of the text:
+                const size_t remaining = tLen - j - 1;
+                if (score > remaining && (score - remaining) > max_dist) {
+                    return max_dist + 1;
+                }
+                ph = (ph << 1) | 1;
+                mh = mh << 1;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+            }
+            return score;
+        }
 
-    //init the distance matrix
-    int dist[MAX_LEN][MAX_LEN] = { 0 };
-    for (int i = 0;i <= len1;i++) {
-        dist[0][i] = i;
-    }
-    for (int j = 0;j <= len2; j++) {
-        dist[j][0] = j;
-    }
-    // calculate
-    for (int j = 1;j <= len1; j++) {
-        for (int i = 1;i <= len2; i++) {
-            int track = 1;
-            if (s1[i - 1] == s2[j - 1]) {
-                track = 0;
+        // Levenshtein distance: dynamic programming, limited to the diagonal band of the width 2*max_dist+1 (Ukkonen)
+        size_t levenshtein_banded(const char *s1, size_t len1, const char *s2, size_t len2, size_t max_dist)
+        {
+            const size_t out_of_range = max_dist + 1;
+            std::vector<size_t> prev(len2 + 1, out_of_range);
+            std::vector<size_t> curr(len2 + 1, out_of_range);
+            for (size_t j = 0; j <= len2 && j <= max_dist; j++) {
+                prev[j] = j;
             }
-            int t = MIN((dist[i - 1][j] + 1), (dist[i][j - 1] + 1));
-            dist[i][j] = MIN(t, (dist[i - 1][j - 1] + track));
+            for (size_t i = 1; i <= len1; i++) {
+                const size_t start = (i > max_dist) ? (i - max_dist) : 1;
+                const size_t end = MIN(len2, i + max_dist);
+                curr[start - 1] = (start == 1 && i <= max_dist) ? i : out_of_range;
+                size_t row_min = curr[start - 1];
+                for (size_t j = start; j <= end; j++) {
+                    const size_t track = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
+                    size_t dist = MIN(prev[j] + 1, curr[j - 1] + 1);
+                    dist = MIN(dist, prev[j - 1] + track);
+                    curr[j] = MIN(dist, out_of_range);
+                    row_min = MIN(row_min, curr[j]);
+                }
+                if (end < len2) {
+                    curr[end + 1] = out_of_range;
+                }
+                if (row_min > max_dist) {
+                    return out_of_range;
+                }
+                prev.swap(curr);
+            }
+            return prev[len2];
         }
-    }
-    return dist[len2][len1];
-}
 
-inline void calc_histogram(const char s1[], size_t hist1[255])
+    }; //namespace util
+}; //namespace paramkit
+
+size_t paramkit::util::levenshtein_distance(const char s1[], const char s2[], size_t max_dist)
 {
-    memset(hist1, 0, 255);
-    const size_t len1 = strlen(s1);
-    for (size_t i = 0; i < len1; i++) {
-        const char c = tolower(s1[i]);
-        hist1[c]++;
+    size_t len1 = strlen(s1);
+    size_t len2 = strlen(s2);
+    if (len1 > len2) {
+        std::swap(s1, s2);
+        std::swap(len1, len2);
     }
+    // the distance is at least the difference of the lengths, and at most the length of the longer string:
+    if (len2 - len1 > max_dist) return max_dist + 1;
+    if (len1 == 0) return len2;
+
+    const size_t MAX_PATTERN = 64;
+    if (len1 <= MAX_PATTERN) {
+        const size_t dist = levenshtein_bitparallel(s1, len1, s2, len2, max_dist);
+        return MIN(dist, max_dist + 1);
+    }
+    return levenshtein_banded(s1, len1, s2, len2, MIN(max_dist, len2));
 }
 
-inline size_t calc_unique_chars(size_t hist1[255])
+size_t paramkit::util::levenshtein_distance(const char s1[], const char s2[])
 {
-    size_t count = 0;
-    for (size_t i = 0; i < 255; i++) {
-        if (hist1[i] != 0) count++;
-    }
-    return count;
+    return levenshtein_distance(s1, s2, (size_t)(-1) - 1);
 }
 
 bool paramkit::util::has_similar_histogram(const char s1[], const char s2[])
 {
-    const size_t MAX_LEN = 255;
-    size_t hist1[MAX_LEN] = { 0 };
-    size_t hist2[MAX_LEN] = { 0 };
-
-    calc_histogram(s1, hist1);
-    calc_histogram(s2, hist2);
-
-    size_t sim = 0;
-    for (size_t i = 0; i < MAX_LEN; i++) {
-        if (hist1[i] != 0 && hist2[i] != 0 ) sim++;
-    }
-    const size_t uniq1 = calc_unique_chars(hist1);
-    const size_t uniq2 = calc_unique_chars(hist2);
-    if (sim == uniq1 && sim == uniq2) {
-        return true;
-    }
-    //
-    return false;
+    return has_similar_histogram(CharsetSignature(s1), CharsetSignature(s2));
 }
 
 paramkit::util::stringsim_type paramkit::util::has_keyword( std::string param, std::string filter)
@@ -131,6 +167,11 @@ paramkit::util::stringsim_type paramkit::util::has_keyword( std::string param, s
 }
 
 paramkit::util::stringsim_type paramkit::util::is_string_similar(const std::string &param, const std::string &filter)
+{
+    return is_string_similar(param, CharsetSignature(param.c_str()), filter, CharsetSignature(filter.c_str()));
+}
+
+paramkit::util::stringsim_type paramkit::util::is_string_similar(const std::string &param, const CharsetSignature &paramCharset, const std::string &filter, const CharsetSignature &filterCharset)
 {
     if (param.empty() || filter.empty()) {
         return SIM_NONE;
@@ -139,8 +180,10 @@ paramkit::util::stringsim_type paramkit::util::is_string_similar(const std::stri
     if (has_keyword(param, filter) != SIM_NONE) {
         return SIM_SUBSTR;
     }
-    size_t dist = util::levenshtein_distance(filter.c_str(), param.c_str());
-    if (dist == 1 || dist <= (param.length() / 2)) {
+    // similar if the distance is 1 or not bigger than a half of the param length, but smaller than both lengths:
+    const size_t max_dist = (param.length() / 2) > 1 ? (param.length() / 2) : 1;
+    const size_t dist = util::levenshtein_distance(filter.c_str(), param.c_str(), max_dist);
+    if (dist <= max_dist) {
         sim_found = true;
     }
     if (dist >= param.length() || dist >= filter.length()) {
@@ -148,8 +191,60 @@ paramkit::util::stringsim_type paramkit::util::is_string_similar(const std::stri
     }
     if (sim_found) return SIM_LAV_DIST;
 
-    sim_found = util::has_similar_histogram(filter.c_str(), param.c_str());
+    sim_found = util::has_similar_histogram(filterCharset, paramCharset);
     if (sim_found) return SIM_HIST;
 
     return SIM_NONE;
 }
+
+void paramkit::util::append_utf8(const char *str, size_t len, std::wstring &out)
+{
+    const uint32_t REPLACEMENT_CHAR = 0xFFFD;
+    const unsigned char *in = reinterpret_cast<const unsigned char*>(str);
+    size_t i = 0;
+    while (i < len) {
+        const unsigned char lead = in[i];
+        size_t seqLen = 0;
+        uint32_t cp = 0;
+        uint32_t minCp = 0;
+        if (lead < 0x80) {
+            out.push_back((wchar_t)lead);
+            i++;
+            continue;
+        }
+        if ((lead & 0xE0) == 0xC0) {
+            seqLen = 2; cp = lead & 0x1F; minCp = 0x80;
+        }
+        else if ((lead & 0xF0) == 0xE0) {
+            seqLen = 3; cp = lead & 0x0F; minCp = 0x800;
+        }
+        else if ((lead & 0xF8) == 0xF0) {
+            seqLen = 4; cp = lead & 0x07; minCp = 0x10000;
+        }
+        bool isValid = (seqLen != 0 && i + seqLen <= len);
+        for (size_t k = 1; isValid && k < seqLen; k++) {
+            if ((in[i + k] & 0xC0) != 0x80) {
+                isValid = false;
+                break;
+            }
+            cp = (cp << 6) | (in[i + k] & 0x3F);
+        }
+        // reject the overlong forms, the surrogates, and the values out of the Unicode range:
+        if (isValid && (cp < minCp || (cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)) {
+            isValid = false;
+        }
+        if (!isValid) {
+            out.push_back((wchar_t)REPLACEMENT_CHAR);
+            i++;
+            continue;
+        }
+        i += seqLen;
+        if (sizeof(wchar_t) == 2 && cp >= 0x10000) {
+            cp -= 0x10000;
+            out.push_back((wchar_t)(0xD800 + (cp >> 10)));
+            out.push_back((wchar_t)(0xDC00 + (cp & 0x3FF)));
+            continue;
+        }
+        out.push_back((wchar_t)cp);
+    }
+}
@@ -0,0 +1,147 @@
+#include "term_sink.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "term_colors.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+
+#else
+#include <unistd.h>
+#endif
+
+paramkit::TermSink& paramkit::TermSink::stdoutSink()
+{
+    static TermSink sink;
+    return sink;
+}
+
+paramkit::TermSink::TermSink()
+    : mode(TERM_NO_COLORS), consoleHandle(nullptr), defaultColor(SILVER),
+    originalConsoleMode(0), isConsoleModeChanged(false)
+{
+#ifdef _WIN32
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD consoleMode = 0;
+    if (hConsole == INVALID_HANDLE_VALUE || !GetConsoleMode(hConsole, &consoleMode)) {
+        return; // not a console
+    }
+    consoleHandle = hConsole;
+    if (SetConsoleMode(hConsole, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING)) {
+        mode = TERM_ANSI; // Windows 10+: the console understands the escape sequences
+        originalConsoleMode = consoleMode;
+        isConsoleModeChanged = !(consoleMode & ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        return;
+    }
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(hConsole, &info)) {
+        defaultColor = info.wAttributes;
+    }
+    mode = TERM_WIN_CONSOLE;
+#else
+    if (!isatty(fileno(stdout))) {
+        return; // not a terminal
+    }
+    const char *term = getenv("TERM");
+    if (term && strcmp(term, "dumb") == 0) {
+        return;
+    }
+    mode = TERM_ANSI;
+#endif
+}
+
+paramkit::TermSink::~TermSink()
+{
+#ifdef _WIN32
+    // the console is shared with the parent process (i.e. cmd.exe): leave it in the mode in which it was found
+    if (isConsoleModeChanged) {
+        std::cout.flush();
+        SetConsoleMode(consoleHandle, originalConsoleMode);
+    }
+#endif
+}
+
+void paramkit::TermSink::appendAnsiColor(std::string &out, int color)
+{
+    // the colors are defined as the Windows console attributes: the bits of the foreground are: blue, green, red, intensity; the background follows
+    const char ansiIndex[] = { 0, 4, 2, 6, 1, 5, 3, 7 }; // BGR bits -> the ANSI color number
+    const int fgColor = color & 0xF;
+    const int bgColor = GET_BG_COLOR(color) & 0xF;
+
+    char buf[32] = { 0 };
+    const int fgCode = ((fgColor & 0x8) ? 90 : 30) + ansiIndex[fgColor & 0x7];
+    if (bgColor == BLACK) {
+        snprintf(buf, sizeof(buf), "\x1b[%dm", fgCode);
+    }
+    else {
+        const int bgCode = ((bgColor & 0x8) ? 100 : 40) + ansiIndex[bgColor & 0x7];
+        snprintf(buf, sizeof(buf), "\x1b[%d;%dm", fgCode, bgCode);
+    }
+    out += buf;
+}
+
+void paramkit::TermSink::print(int color, const std::string &text)
+{
+    ColoredText colored;
+    colored.append(color, text);
+    print(colored);
+}
+
+void paramkit::TermSink::print(const ColoredText &colored)
+{
+    const std::string &text = colored.str();
+    const std::vector<ColoredText::ColorSpan> &spans = colored.colorSpans();
+    if (mode == TERM_NO_COLORS || spans.empty()) {
+        std::cout.write(text.c_str(), text.length());
+        return;
+    }
+    if (mode == TERM_WIN_CONSOLE) {
+        printWithAttributes(colored);
+        return;
+    }
+    // TERM_ANSI: embed the colors in the text, and print it at once
+    const char ansiReset[] = "\x1b[0m";
+    std::string out;
+    out.reserve(text.length() + spans.size() * (sizeof(ansiReset) * 3));
+    size_t pos = 0;
+    std::vector<ColoredText::ColorSpan>::const_iterator itr;
+    for (itr = spans.begin(); itr != spans.end(); ++itr) {
+        out.append(text, pos, itr->offset - pos);
+        appendAnsiColor(out, itr->color);
+        out.append(text, itr->offset, itr->length);
+        out += ansiReset;
+        pos = itr->offset + itr->length;
+    }
+    out.append(text, pos, text.length() - pos);
+    std::cout.write(out.c_str(), out.length());
+}
+
+void paramkit::TermSink::printWithAttributes(const ColoredText &colored)
+{
+#ifdef _WIN32
+    const std::string &text = colored.str();
+    const std::vector<ColoredText::ColorSpan> &spans = colored.colorSpans();
+    size_t pos = 0;
+    std::vector<ColoredText::ColorSpan>::const_iterator itr;
+    for (itr = spans.begin(); itr != spans.end(); ++itr) {
+        std::cout.write(text.c_str() + pos, itr->offset - pos);
+        std::cout.flush();
+        SetConsoleTextAttribute(consoleHandle, (WORD)itr->color);
+        std::cout.write(text.c_str() + itr->offset, itr->length);
+        std::cout.flush();
+        SetConsoleTextAttribute(consoleHandle, (WORD)defaultColor); // back to the default color
+        pos = itr->offset + itr->length;
+    }
+    std::cout.write(text.c_str() + pos, text.length() - pos);
+#else
+    std::cout.write(colored.str().c_str(), colored.str().length());
+#endif
+}
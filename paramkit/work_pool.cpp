@@ -0,0 +1,192 @@
+#include "work_pool.h"
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <system_error>
+
+namespace {
+
+    //! A range of the items: [start, end)
+    struct WorkChunk {
+        size_t start;
+        size_t end;
+    };
+
+    //! The chunks assigned to a single thread. The owner takes them from the back, the thieves from the front.
+    class WorkQueue {
+    public:
+        void push(const WorkChunk &chunk)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.push_back(chunk);
+        }
+
+        bool popOwn(WorkChunk &chunk)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (chunks.empty()) return false;
+            chunk = chunks.back();
+            chunks.pop_back();
+            return true;
+        }
+
+        bool steal(WorkChunk &chunk)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (chunks.empty()) return false;
+            chunk = chunks.front();
+            chunks.pop_front();
+            return true;
+        }
+
+    protected:
+        std::mutex mutex;
+        std::deque<WorkChunk> chunks;
+    };
+
+    void process_queues(std::vector<WorkQueue> &queues, size_t ownId, const std::function<void(size_t)> &task, const std::atomic<bool> &isFailed)
+    {
+        const size_t queuesCount = queues.size();
+        WorkChunk chunk;
+        while (!isFailed) {
+            bool found = queues[ownId].popOwn(chunk);
+            // the own queue is empty: try to steal from the others
+            for (size_t i = 1; !found && i < queuesCount; i++) {
+                found = queues[(ownId + i) % queuesCount].steal(chunk);
+            }
+            if (!found) {
+                // no new chunks are added during the processing, so all the work is taken
+                return;
+            }
+            for (size_t item = chunk.start; item < chunk.end && !isFailed; item++) {
+                task(item);
+            }
+        }
+    }
+
+}; // anonymous namespace
+
+size_t paramkit::util::WorkStealingPool::defaultThreadsCount()
+{
+    const size_t count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+paramkit::util::WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    batchReady.notify_all();
+    std::vector<std::thread>::iterator itr;
+    for (itr = workers.begin(); itr != workers.end(); ++itr) {
+        itr->join();
+    }
+}
+
+size_t paramkit::util::WorkStealingPool::startWorkers(size_t threadsCount)
+{
+    while (workers.size() + 1 < threadsCount) {
+        try {
+            // the worker waits for the batches following the current one:
+            workers.push_back(std::thread(&WorkStealingPool::workerLoop, this, workers.size() + 1, batchId));
+        }
+        catch (const std::system_error &) {
+            break; // use the threads that were started so far
+        }
+    }
+    return (workers.size() + 1 < threadsCount) ? (workers.size() + 1) : threadsCount;
+}
+
+void paramkit::util::WorkStealingPool::workerLoop(size_t workerId, size_t seenBatchId)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        batchReady.wait(lock, [this, seenBatchId]() { return stopping || batchId != seenBatchId; });
+        if (stopping) return;
+
+        seenBatchId = batchId;
+        if (workerId >= batchThreads) continue; // not needed for this batch
+
+        const std::function<void(size_t)> *job = batchJob;
+        lock.unlock();
+        (*job)(workerId);
+        lock.lock();
+        if (--busyWorkers == 0) {
+            batchDone.notify_all();
+        }
+    }
+}
+
+void paramkit::util::WorkStealingPool::run(size_t itemsCount, const std::function<void(size_t)> &task, size_t threadsCount, size_t chunkSize)
+{
+    if (!itemsCount) return;
+
+    if (!threadsCount) {
+        threadsCount = defaultThreadsCount();
+    }
+    if (!chunkSize) {
+        // a few chunks per thread, to leave something to steal:
+        const size_t CHUNKS_PER_THREAD = 8;
+        chunkSize = itemsCount / (threadsCount * CHUNKS_PER_THREAD);
+        if (!chunkSize) chunkSize = 1;
+    }
+    const size_t chunksCount = (itemsCount + chunkSize - 1) / chunkSize;
+    if (threadsCount > chunksCount) {
+        threadsCount = chunksCount;
+    }
+    std::lock_guard<std::mutex> runLock(runMutex);
+    if (threadsCount > 1) {
+        threadsCount = startWorkers(threadsCount);
+    }
+    if (threadsCount <= 1) {
+        for (size_t item = 0; item < itemsCount; item++) {
+            task(item);
+        }
+        return;
+    }
+    // assign the consecutive chunks to the threads:
+    std::vector<WorkQueue> queues(threadsCount);
+    for (size_t chunkId = 0; chunkId < chunksCount; chunkId++) {
+        WorkChunk chunk;
+        chunk.start = chunkId * chunkSize;
+        chunk.end = (chunk.start + chunkSize < itemsCount) ? (chunk.start + chunkSize) : itemsCount;
+        queues[(chunkId * threadsCount) / chunksCount].push(chunk);
+    }
+    // the first exception thrown by the task stops the processing, and is passed to the caller:
+    std::atomic<bool> isFailed(false);
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    const std::function<void(size_t)> job = [&](size_t threadId) {
+        try {
+            process_queues(queues, threadId, task, isFailed);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure) failure = std::current_exception();
+            isFailed = true;
+        }
+    };
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batchJob = &job;
+        batchThreads = threadsCount;
+        busyWorkers = threadsCount - 1;
+        batchId++;
+    }
+    batchReady.notify_all();
+    job(0);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        batchDone.wait(lock, [this]() { return busyWorkers == 0; });
+        batchJob = nullptr;
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
@@ -0,0 +1,141 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    const size_t ENTRIES_COUNT = 10000;
+
+    //! The schema of ENTRIES_COUNT parameters: the numbers and the strings, alternately
+    void build_schema(Params &params)
+    {
+        for (size_t i = 0; i < ENTRIES_COUNT; i++) {
+            const std::string name = "param" + std::to_string(i);
+            if (i % 2) {
+                params.emplaceParam<IntParam>(name, false);
+            }
+            else {
+                params.emplaceParam<StringParam>(name, false);
+            }
+        }
+    }
+
+    std::string entry_value(size_t i)
+    {
+        return (i % 2) ? std::to_string(i * 7) : ("value " + std::to_string(i));
+    }
+
+    std::string make_ini()
+    {
+        std::string content = "; the generated configuration\n[all]\n";
+        for (size_t i = 0; i < ENTRIES_COUNT; i++) {
+            content += "param" + std::to_string(i) + " = " + entry_value(i) + "\n";
+        }
+        return content;
+    }
+
+    std::string make_json()
+    {
+        std::string content = "{\n";
+        for (size_t i = 0; i < ENTRIES_COUNT; i++) {
+            if (i) content += ",\n";
+            content += "  \"param" + std::to_string(i) + "\": ";
+            content += (i % 2) ? entry_value(i) : ("\"" + entry_value(i) + "\"");
+        }
+        content += "\n}\n";
+        return content;
+    }
+
+    void report_time(const std::string &label, double totalMs, size_t rounds)
+    {
+        report(label + ", time", totalMs / rounds, "ms per config");
+        report(label + ", per entry", totalMs * 1e6 / (rounds * ENTRIES_COUNT), "ns");
+    }
+
+    //! Loads the configuration from the buffer
+    void bench_buffer(Params &params, const std::string &content, t_config_format format, const std::string &label)
+    {
+        const size_t rounds = 5;
+        size_t loaded = 0;
+        std::vector<ConfigError> errors;
+        Timer timer;
+        for (size_t round = 0; round < rounds; round++) {
+            errors.clear();
+            if (params.loadConfig(content.c_str(), content.length(), errors, format)) loaded++;
+        }
+        const double totalMs = timer.elapsedMs();
+        keep(loaded);
+        if (loaded != rounds) {
+            std::cout << label << ": loading failed\n";
+        }
+        report_time(label, totalMs, rounds);
+    }
+
+    //! Loads the configuration from the mapped file
+    void bench_file(Params &params, const std::string &content, const std::string &label)
+    {
+        const char *path = "bench_config.ini";
+        FILE *fp = fopen(path, "wb");
+        if (!fp) return;
+        fwrite(content.c_str(), 1, content.length(), fp);
+        fclose(fp);
+
+        const size_t rounds = 5;
+        size_t loaded = 0;
+        std::vector<ConfigError> errors;
+        Timer timer;
+        for (size_t round = 0; round < rounds; round++) {
+            errors.clear();
+            if (params.loadConfig(path, errors, CONFIG_INI)) loaded++;
+        }
+        const double totalMs = timer.elapsedMs();
+        keep(loaded);
+        remove(path);
+        report_time(label, totalMs, rounds);
+    }
+
+    //! The same entries expanded into the argument vector: the way they were passed before
+    void bench_argv(Params &params)
+    {
+        std::vector<std::string> storage;
+        storage.push_back("prog");
+        for (size_t i = 0; i < ENTRIES_COUNT; i++) {
+            storage.push_back("/param" + std::to_string(i));
+            storage.push_back(entry_value(i));
+        }
+        std::vector<char*> argv;
+        for (size_t i = 0; i < storage.size(); i++) {
+            argv.push_back(&storage[i][0]);
+        }
+        const size_t rounds = 5;
+        size_t parsed = 0;
+        Timer timer;
+        for (size_t round = 0; round < rounds; round++) {
+            if (params.parse((int)argv.size(), &argv[0])) parsed++;
+        }
+        const double totalMs = timer.elapsedMs();
+        keep(parsed);
+        report_time("argv", totalMs, rounds);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    Params params;
+    build_schema(params);
+    std::cout << "configuration of " << ENTRIES_COUNT << " entries:\n";
+    const std::string ini = make_ini();
+    bench_buffer(params, ini, CONFIG_INI, "INI, buffer");
+    bench_file(params, ini, "INI, mapped file");
+    bench_buffer(params, make_json(), CONFIG_JSON, "JSON, buffer");
+    bench_argv(params);
+    return 0;
+}
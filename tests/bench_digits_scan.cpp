@@ -0,0 +1,56 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    const t_scan_impl g_impls[] = { SCAN_IMPL_SCALAR, SCAN_IMPL_SSE2, SCAN_IMPL_AVX2, SCAN_IMPL_AUTO };
+    const char *g_implNames[] = { "scalar", "SSE2", "AVX2", "auto" };
+
+    //! Classifies the buffer in the chunks of the given length, reporting the throughput of each implementation
+    void bench_chunks(const std::string &buf, size_t chunkLen)
+    {
+        const size_t rounds = 10;
+        for (size_t k = 0; k < sizeof(g_impls) / sizeof(g_impls[0]); k++) {
+            int flags = 0;
+            if (!scan_digits_with(g_impls[k], buf.data(), chunkLen, flags)) {
+                std::cout << g_implNames[k] << ": not supported\n";
+                continue;
+            }
+            size_t sum = 0;
+            Timer timer;
+            for (size_t round = 0; round < rounds; round++) {
+                for (size_t offset = 0; offset + chunkLen <= buf.length(); offset += chunkLen) {
+                    scan_digits_with(g_impls[k], buf.data() + offset, chunkLen, flags);
+                    sum += flags;
+                }
+            }
+            const double ms = timer.elapsedMs();
+            keep(sum);
+            const double megabytes = (double)(rounds * buf.length()) / (1024 * 1024);
+            report(std::string(g_implNames[k]) + ", chunks of " + std::to_string(chunkLen), megabytes * 1000 / ms, "MB/s");
+        }
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    // the hexadecimal digits, as in a long list of the addresses:
+    const char digits[] = "0123456789abcdefABCDEF";
+    std::string buf(1024 * 1024, '0');
+    for (size_t i = 0; i < buf.length(); i++) {
+        buf[i] = digits[(i * 7) % (sizeof(digits) - 1)];
+    }
+    const size_t chunkLens[] = { 8, 16, 64, 4096, buf.length() };
+    for (size_t i = 0; i < sizeof(chunkLens) / sizeof(chunkLens[0]); i++) {
+        bench_chunks(buf, chunkLens[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <paramkit.h>
+
+#include <string>
+#include <fstream>
+#include <iostream>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+#ifdef _WIN32
+    const char NULL_DEVICE[] = "NUL";
+#else
+    const char NULL_DEVICE[] = "/dev/null";
+#endif
+
+    //! The schema with the descriptions, split into groups
+    class HelpParams : public Params {
+    public:
+        HelpParams(size_t paramsCount)
+        {
+            const size_t groupsCount = 10;
+            for (size_t g = 0; g < groupsCount; g++) {
+                addGroup(new ParamGroup("Group" + std::to_string(g)));
+            }
+            for (size_t i = 0; i < paramsCount; i++) {
+                const std::string name = "param" + std::to_string(i);
+                addParam(new IntParam(name, (i % 7) == 0));
+                setInfo(name, "The description of the parameter number " + std::to_string(i), "\tThe extended info.\n");
+                addParamToGroup(name, "Group" + std::to_string(i % groupsCount));
+            }
+        }
+    };
+
+    //! Prints the full help to the null device in the given terminal mode
+    void bench_print(HelpParams &params, t_term_mode mode, const std::string &label)
+    {
+        std::ofstream nullOut(NULL_DEVICE);
+        std::streambuf *prevBuf = std::cout.rdbuf(nullOut.rdbuf());
+        TermSink &sink = TermSink::stdoutSink();
+        const t_term_mode prevMode = sink.getMode();
+        sink.setMode(mode);
+
+        const size_t rounds = 20;
+        Timer timer;
+        for (size_t round = 0; round < rounds; round++) {
+            params.printInfo();
+        }
+        std::cout.flush();
+        const double totalMs = timer.elapsedMs();
+
+        sink.setMode(prevMode);
+        std::cout.rdbuf(prevBuf);
+        report(label, totalMs * 1e3 / rounds, "us per help");
+    }
+
+    //! Renders the full help without the cache: each round is preceded by the change of a description
+    void bench_render(HelpParams &params)
+    {
+        const size_t rounds = 20;
+        size_t length = 0;
+        Timer timer;
+        for (size_t round = 0; round < rounds; round++) {
+            params.setInfo("param0", "The changed description " + std::to_string(round));
+            length += params.renderInfo().str().length();
+        }
+        const double totalMs = timer.elapsedMs();
+        keep(length);
+        report("help rendering, uncached", totalMs * 1e3 / rounds, "us per help");
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    const size_t paramsCount = 500;
+    HelpParams params(paramsCount);
+    std::cout << "full help of " << paramsCount << " params, printed to " << NULL_DEVICE << ":\n";
+    bench_print(params, TERM_NO_COLORS, "help, no colors");
+    bench_print(params, TERM_ANSI, "help, ANSI colors");
+    bench_render(params);
+    return 0;
+}
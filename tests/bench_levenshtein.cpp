@@ -0,0 +1,106 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    //! The previous implementation: the full distance matrix on the stack
+    size_t matrix_distance(const char s1[], const char s2[])
+    {
+        const size_t MAX_LEN = 100;
+        const size_t len1 = strlen(s1);
+        const size_t len2 = strlen(s2);
+        if (len1 >= MAX_LEN || len2 >= MAX_LEN) return (size_t)(-1);
+
+        int dist[MAX_LEN][MAX_LEN] = { { 0 } };
+        for (size_t i = 0; i <= len1; i++) dist[i][0] = (int)i;
+        for (size_t j = 0; j <= len2; j++) dist[0][j] = (int)j;
+        for (size_t i = 1; i <= len1; i++) {
+            for (size_t j = 1; j <= len2; j++) {
+                const int track = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
+                const int t = std::min(dist[i - 1][j] + 1, dist[i][j - 1] + 1);
+                dist[i][j] = std::min(t, dist[i - 1][j - 1] + track);
+            }
+        }
+        return dist[len1][len2];
+    }
+
+    std::string random_name(uint64_t &seed, size_t len)
+    {
+        std::string name;
+        for (size_t i = 0; i < len; i++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            name.push_back((char)('a' + (seed >> 33) % 26));
+        }
+        return name;
+    }
+
+    //! Measures the distances between the query and all the names
+    void bench(const std::string &label, const std::string &query, const std::vector<std::string> &names)
+    {
+        const size_t rounds = 20;
+        const size_t count = rounds * names.size();
+        size_t sum = 0;
+        size_t mismatches = 0;
+
+        Timer matrixTimer;
+        for (size_t round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < names.size(); i++) {
+                sum += matrix_distance(query.c_str(), names[i].c_str());
+            }
+        }
+        const double matrixMs = matrixTimer.elapsedMs();
+        report(label + ", matrix", matrixMs * 1e6 / count, "ns per pair");
+
+        Timer bitTimer;
+        for (size_t round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < names.size(); i++) {
+                sum += util::levenshtein_distance(query.c_str(), names[i].c_str());
+            }
+        }
+        const double bitMs = bitTimer.elapsedMs();
+        report(label + ", bit-parallel", bitMs * 1e6 / count, "ns per pair");
+
+        const size_t caps[] = { 8, 3, 1 };
+        for (size_t c = 0; c < sizeof(caps) / sizeof(caps[0]); c++) {
+            Timer cappedTimer;
+            for (size_t round = 0; round < rounds; round++) {
+                for (size_t i = 0; i < names.size(); i++) {
+                    sum += util::levenshtein_distance(query.c_str(), names[i].c_str(), caps[c]);
+                }
+            }
+            const double cappedMs = cappedTimer.elapsedMs();
+            report(label + ", bit-parallel, cap " + std::to_string(caps[c]), cappedMs * 1e6 / count, "ns per pair");
+        }
+        for (size_t i = 0; i < names.size(); i++) {
+            if (matrix_distance(query.c_str(), names[i].c_str()) != util::levenshtein_distance(query.c_str(), names[i].c_str())) mismatches++;
+        }
+        keep(sum);
+        if (mismatches) {
+            std::cout << label << ": " << mismatches << " results differ from the matrix!\n";
+        }
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    uint64_t seed = 1;
+    const size_t lens[] = { 8, 24, 60 };
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < 2000; i++) {
+            names.push_back(random_name(seed, lens[l] / 2 + (i % lens[l])));
+        }
+        const std::string query = random_name(seed, lens[l]);
+        bench("names of ~" + std::to_string(lens[l]) + " chars", query, names);
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    const size_t QUERIES_COUNT = 200000;
+
+    uint64_t next_random(uint64_t &seed)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return seed >> 11;
+    }
+
+    //! The queries: half of them hit the values, the other half (most likely) miss
+    std::vector<uint64_t> make_queries(const std::vector<uint64_t> &values, uint64_t range)
+    {
+        std::vector<uint64_t> queries;
+        uint64_t seed = 7;
+        for (size_t i = 0; i < QUERIES_COUNT; i++) {
+            const uint64_t r = next_random(seed);
+            queries.push_back((i % 2) ? values[r % values.size()] : (r % range));
+        }
+        return queries;
+    }
+
+    //! Compares the lookups in the MembershipSet with the std::set, and the linear scan of the list (as it was done before)
+    void bench_values(const std::vector<uint64_t> &values, uint64_t range, const std::string &label)
+    {
+        util::MembershipSet membership;
+        membership.build(values);
+        const char *kindNames[] = { "empty", "bitmap", "sorted", "hashed" };
+        const std::vector<uint64_t> queries = make_queries(values, range);
+
+        size_t found = 0;
+        Timer setTimer;
+        for (size_t i = 0; i < queries.size(); i++) {
+            if (membership.contains(queries[i])) found++;
+        }
+        const double setMs = setTimer.elapsedMs();
+        report(label + ", MembershipSet (" + kindNames[membership.getKind()] + ")", setMs * 1e6 / queries.size(), "ns per lookup");
+
+        const std::set<uint64_t> stdSet(values.begin(), values.end());
+        Timer stdTimer;
+        for (size_t i = 0; i < queries.size(); i++) {
+            if (stdSet.find(queries[i]) != stdSet.end()) found++;
+        }
+        const double stdMs = stdTimer.elapsedMs();
+        report(label + ", std::set", stdMs * 1e6 / queries.size(), "ns per lookup");
+
+        // the linear scan is slow for the long lists: measured on a part of the queries
+        const size_t scanQueries = std::min(queries.size(), (size_t)(20000000 / values.size()) + 1);
+        Timer scanTimer;
+        for (size_t i = 0; i < scanQueries; i++) {
+            if (std::find(values.begin(), values.end(), queries[i]) != values.end()) found++;
+        }
+        const double scanMs = scanTimer.elapsedMs();
+        report(label + ", linear scan", scanMs * 1e6 / scanQueries, "ns per lookup");
+        keep(found);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    uint64_t seed = 1;
+    // dense: within a small range
+    std::vector<uint64_t> dense;
+    for (uint64_t i = 0; i < 10000; i++) {
+        if (i % 4) dense.push_back(i);
+    }
+    bench_values(dense, 10000, "7500 dense values");
+
+    // a few sparse values
+    std::vector<uint64_t> few;
+    for (size_t i = 0; i < util::MembershipSet::SORTED_MAX; i++) {
+        few.push_back(next_random(seed));
+    }
+    bench_values(few, (uint64_t)1 << 53, std::to_string(few.size()) + " sparse values");
+
+    // many sparse values
+    std::vector<uint64_t> many;
+    for (size_t i = 0; i < 10000; i++) {
+        many.push_back(next_random(seed));
+    }
+    bench_values(many, (uint64_t)1 << 53, "10000 sparse values");
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    //! The previous path: parsing through the stringstream
+    uint64_t load_by_stream(const char *str)
+    {
+        uint64_t val = 0;
+        std::stringstream ss;
+        if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+            ss << std::hex << (str + 2);
+        }
+        else {
+            ss << std::dec << str;
+        }
+        ss >> val;
+        return val;
+    }
+
+    void bench(const std::string &name, const std::vector<std::string> &numbers)
+    {
+        const size_t rounds = 20;
+        const size_t count = rounds * numbers.size();
+
+        uint64_t sum = 0;
+        Timer streamTimer;
+        for (size_t round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < numbers.size(); i++) {
+                sum += load_by_stream(numbers[i].c_str());
+            }
+        }
+        const double streamMs = streamTimer.elapsedMs();
+
+        Timer loadTimer;
+        for (size_t round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < numbers.size(); i++) {
+                uint64_t val = 0;
+                load_number(numbers[i].c_str(), numbers[i].length(), val);
+                sum += val;
+            }
+        }
+        const double loadMs = loadTimer.elapsedMs();
+        keep(sum);
+
+        report(name + ", stringstream", streamMs * 1e6 / count, "ns per number");
+        report(name + ", load_number", loadMs * 1e6 / count, "ns per number");
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    const size_t count = 100000;
+    std::vector<std::string> decimals;
+    std::vector<std::string> addresses;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        decimals.push_back(std::to_string(seed >> 44));
+
+        std::stringstream ss;
+        ss << "0x" << std::hex << (0x7ff000000000ULL | (seed >> 28));
+        addresses.push_back(ss.str());
+    }
+    bench("decimal (PIDs)", decimals);
+    bench("hex (addresses)", addresses);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    //! Parses the command line setting all the parameters: with the dispatch index, the time per argument grows only logarithmically with the count of the parameters
+    void bench_cmdline(size_t paramsCount)
+    {
+        Params params;
+        for (size_t i = 0; i < paramsCount; i++) {
+            params.emplaceParam<IntParam>("param" + std::to_string(i), false);
+        }
+        std::vector<std::string> storage;
+        storage.push_back("prog");
+        for (size_t i = 0; i < paramsCount; i++) {
+            storage.push_back("/param" + std::to_string(i));
+            storage.push_back(std::to_string(i));
+        }
+        std::vector<char*> argv;
+        for (size_t i = 0; i < storage.size(); i++) {
+            argv.push_back(&storage[i][0]);
+        }
+
+        const size_t rounds = 10;
+        size_t parsed = 0;
+        Timer timer;
+        for (size_t round = 0; round < rounds; round++) {
+            if (params.parse((int)argv.size(), &argv[0])) parsed++;
+        }
+        const double totalMs = timer.elapsedMs();
+        keep(parsed);
+        report("parse, " + std::to_string(paramsCount) + " params", totalMs * 1e6 / (rounds * paramsCount), "ns per param");
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    const size_t counts[] = { 10, 100, 1000, 10000 };
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        bench_cmdline(counts[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    const size_t PARAMS_COUNT = 20;
+    const size_t CMDLINES_COUNT = 2000;
+
+    //! Measures the throughput of parsing the batch with the given number of the threads
+    void bench_threads(const Params &params, const std::vector< std::vector<char*> > &argvs, util::WorkStealingPool &pool, size_t threadsCount)
+    {
+        std::vector<ParsedValues> results;
+        params.parseBatch(argvs, results, pool, threadsCount); // warm up: starts the threads, and allocates the stores
+
+        const size_t rounds = 5;
+        size_t parsed = 0;
+        Timer timer;
+        for (size_t round = 0; round < rounds; round++) {
+            parsed += params.parseBatch(argvs, results, pool, threadsCount);
+        }
+        const double totalMs = timer.elapsedMs();
+        keep(parsed);
+        report("parseBatch, " + std::to_string(threadsCount) + " threads", (rounds * argvs.size()) / (totalMs / 1000), "cmdlines per second");
+    }
+
+}; // anonymous namespace
+
+//! Optional argument: the maximal number of the threads (by default: the number of the hardware threads)
+int main(int argc, char *argv[])
+{
+    Params params;
+    for (size_t i = 0; i < PARAMS_COUNT; i++) {
+        params.addParam(new IntParam("param" + std::to_string(i), (i % 5) == 0));
+    }
+    // each command line sets all the parameters:
+    std::vector<std::string> storage;
+    for (size_t i = 0; i < PARAMS_COUNT; i++) {
+        storage.push_back("/param" + std::to_string(i));
+        storage.push_back(std::to_string(i * 1000));
+    }
+    std::vector< std::vector<char*> > argvs(CMDLINES_COUNT);
+    for (size_t i = 0; i < argvs.size(); i++) {
+        argvs[i].push_back(const_cast<char*>("prog"));
+        for (size_t j = 0; j < storage.size(); j++) {
+            argvs[i].push_back(&storage[j][0]);
+        }
+    }
+
+    util::WorkStealingPool pool;
+    size_t maxThreads = util::WorkStealingPool::defaultThreadsCount();
+    if (argc > 1 && atoi(argv[1]) > 0) {
+        maxThreads = (size_t)atoi(argv[1]);
+    }
+    std::cout << CMDLINES_COUNT << " command lines of " << PARAMS_COUNT << " params, up to " << maxThreads << " threads:\n";
+    for (size_t threadsCount = 1; threadsCount <= maxThreads; threadsCount *= 2) {
+        bench_threads(params, argvs, pool, threadsCount);
+    }
+    if ((maxThreads & (maxThreads - 1)) != 0) {
+        bench_threads(params, argvs, pool, maxThreads); // not a power of 2
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <new>
+#include <cstdlib>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    //! The heap usage of the program: each allocated block is preceded by a header storing its size
+    struct HeapStats {
+        size_t allocations;
+        size_t currentBytes;
+        size_t peakBytes;
+    };
+
+    HeapStats g_heap = { 0, 0, 0 };
+
+    const size_t HEADER_SIZE = 16; // keeps the alignment of the returned blocks
+
+}; // anonymous namespace
+
+void* operator new(size_t size)
+{
+    char *block = (char*)malloc(size + HEADER_SIZE);
+    if (!block) throw std::bad_alloc();
+    *(size_t*)block = size;
+    g_heap.allocations++;
+    g_heap.currentBytes += size;
+    if (g_heap.currentBytes > g_heap.peakBytes) {
+        g_heap.peakBytes = g_heap.currentBytes;
+    }
+    return block + HEADER_SIZE;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (!ptr) return;
+    char *block = (char*)ptr - HEADER_SIZE;
+    g_heap.currentBytes -= *(size_t*)block;
+    free(block);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+namespace {
+
+    const size_t PARAMS_COUNT = 1000;
+
+    const char BASIC_INFO[] = "The description of the parameter, long enough not to fit in the small string buffer";
+    const char EXTENDED_INFO[] = "\tThe extended description of the parameter, listing the details of the accepted values.\n";
+
+    //! The ways in which the descriptions are set
+    typedef enum {
+        INFO_NONE = 0, ///< without the descriptions
+        INFO_COPIED, ///< the descriptions are set by setInfo: the repeated ones are interned
+        INFO_STATIC ///< the descriptions are set by setInfoStatic: referencing the literals
+    } t_info_mode;
+
+    //! Builds the schema of PARAMS_COUNT parameters, allocating each of them separately, or in the arena
+    void build_schema(Params &params, bool inArena, t_info_mode infoMode = INFO_NONE)
+    {
+        for (size_t i = 0; i < PARAMS_COUNT; i++) {
+            const std::string name = "param" + std::to_string(i);
+            const bool isRequired = (i % 10) == 0;
+            if (inArena) {
+                params.emplaceParam<IntParam>(name, isRequired);
+            }
+            else {
+                params.addParam(new IntParam(name, isRequired));
+            }
+            if (infoMode == INFO_COPIED) {
+                params.setInfo(name, BASIC_INFO, EXTENDED_INFO);
+            }
+            else if (infoMode == INFO_STATIC) {
+                params.setInfoStatic(name, BASIC_INFO, EXTENDED_INFO);
+            }
+        }
+    }
+
+    //! Measures the time of building the schema, and its heap usage
+    void bench_build(bool inArena, const std::string &label)
+    {
+        const size_t rounds = 10;
+        double totalMs = 0;
+        size_t allocations = 0;
+        size_t peakBytes = 0;
+        for (size_t round = 0; round < rounds; round++) {
+            const size_t initialAllocations = g_heap.allocations;
+            const size_t initialBytes = g_heap.currentBytes;
+            g_heap.peakBytes = initialBytes;
+
+            Params *params = new Params();
+            Timer timer;
+            build_schema(*params, inArena);
+            totalMs += timer.elapsedMs();
+
+            allocations = g_heap.allocations - initialAllocations;
+            peakBytes = g_heap.peakBytes - initialBytes;
+            delete params;
+        }
+        report(label + ", build time", totalMs * 1e3 / rounds, "us per schema");
+        report(label + ", allocations", (double)allocations, "per schema");
+        report(label + ", peak heap", (double)peakBytes / 1024, "KB");
+    }
+
+    //! Returns the heap used by the schema after it is built
+    size_t schema_heap(t_info_mode infoMode)
+    {
+        const size_t initialBytes = g_heap.currentBytes;
+        Params *params = new Params();
+        build_schema(*params, true, infoMode);
+        const size_t bytes = g_heap.currentBytes - initialBytes;
+        delete params;
+        return bytes;
+    }
+
+    //! Returns the heap used by the descriptions stored as separate copies in std::strings (as they were stored before)
+    size_t copied_descriptions_heap()
+    {
+        const size_t initialBytes = g_heap.currentBytes;
+        std::vector<std::string> *infos = new std::vector<std::string>(PARAMS_COUNT * 2);
+        for (size_t i = 0; i < PARAMS_COUNT; i++) {
+            (*infos)[i * 2] = BASIC_INFO;
+            (*infos)[i * 2 + 1] = EXTENDED_INFO;
+        }
+        const size_t bytes = g_heap.currentBytes - initialBytes - (PARAMS_COUNT * 2 * sizeof(std::string) + sizeof(std::vector<std::string>));
+        delete infos;
+        return bytes;
+    }
+
+    //! Reports the memory used per parameter, depending on how the descriptions are stored
+    void bench_bytes_per_param()
+    {
+        const size_t bare = schema_heap(INFO_NONE);
+        const size_t copied = schema_heap(INFO_COPIED);
+        const size_t literals = schema_heap(INFO_STATIC);
+        const size_t previous = bare + copied_descriptions_heap();
+
+        report("bytes per param, without the descriptions", (double)bare / PARAMS_COUNT, "B");
+        report("bytes per param, descriptions as std::string copies (before)", (double)previous / PARAMS_COUNT, "B");
+        report("bytes per param, descriptions by setInfo (interned)", (double)copied / PARAMS_COUNT, "B");
+        report("bytes per param, descriptions by setInfoStatic", (double)literals / PARAMS_COUNT, "B");
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    std::cout << "schema of " << PARAMS_COUNT << " params:\n";
+    bench_build(false, "new + addParam");
+    bench_build(true, "emplaceParam");
+    bench_bytes_per_param();
+    return 0;
+}
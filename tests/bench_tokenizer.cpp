@@ -0,0 +1,99 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+
+using namespace paramkit;
+using namespace paramkit_bench;
+
+namespace {
+
+    const size_t INPUT_SIZE = 4 * 1024 * 1024;
+
+    //! Makes the command line of the given size, with the arguments quoted according to the style
+    template <typename T_CHAR>
+    std::basic_string<T_CHAR> make_cmdline(t_cmdline_style style)
+    {
+        const char *windowsArgs[] = { "/path", "\"C:\\\\Program Files\\\\app\\\\file name.txt\"", "plain", "\"say \\\"hi\\\"\"", "C:\\\\dir\\\\" };
+        const char *posixArgs[] = { "/path", "'/home/user/file name.txt'", "plain", "\"say \\\"hi\\\"\"", "escaped\\ space" };
+        const char **args = (style == CMDLINE_WINDOWS) ? windowsArgs : posixArgs;
+        const size_t argsCount = 5;
+        const T_CHAR separator = (style == CMDLINE_NUL_SEPARATED) ? 0 : ' ';
+
+        std::basic_string<T_CHAR> cmdline;
+        cmdline.reserve(INPUT_SIZE + 64);
+        for (size_t i = 0; cmdline.length() < INPUT_SIZE; i++) {
+            const char *arg = (style == CMDLINE_NUL_SEPARATED) ? "/proc/self/cmdline-like argument" : args[i % argsCount];
+            for (const char *c = arg; *c; c++) {
+                cmdline.push_back((T_CHAR)*c);
+            }
+            cmdline.push_back(separator);
+        }
+        return cmdline;
+    }
+
+    //! Measures the throughput of splitting the command line in place
+    template <typename T_CHAR>
+    void bench_style(t_cmdline_style style, const std::string &label)
+    {
+        const std::basic_string<T_CHAR> cmdline = make_cmdline<T_CHAR>(style);
+        std::vector<T_CHAR> buf(cmdline.begin(), cmdline.end());
+        buf.push_back(0);
+        std::vector<T_CHAR*> argv;
+
+        const size_t rounds = 5;
+        double totalMs = 0;
+        for (size_t round = 0; round < rounds; round++) {
+            std::copy(cmdline.begin(), cmdline.end(), buf.begin()); // the tokenizer modifies the buffer
+            argv.clear();
+            Timer timer;
+            CmdlineTokenizer<T_CHAR> tokenizer(&buf[0], cmdline.length(), style);
+            tokenizer.tokenize(argv);
+            totalMs += timer.elapsedMs();
+        }
+        keep(argv.size());
+        const double megabytes = (double)(cmdline.length() * sizeof(T_CHAR)) / (1024 * 1024);
+        report(label, megabytes * rounds / (totalMs / 1000), "MB/s");
+    }
+
+    //! Measures the throughput of parsing the command line by Params, tokenized on the fly
+    void bench_parse()
+    {
+        Params params;
+        params.addParam(new IntParam("num", false));
+        params.addParam(new StringParam("path", false));
+        std::string cmdline = "prog";
+        while (cmdline.length() < INPUT_SIZE / 4) {
+            cmdline += " /num 12345 /path \"/home/user/file name.txt\"";
+        }
+        std::vector<char> buf(cmdline.length() + 1);
+        const size_t rounds = 5;
+        double totalMs = 0;
+        size_t parsed = 0;
+        for (size_t round = 0; round < rounds; round++) {
+            std::copy(cmdline.begin(), cmdline.end(), buf.begin());
+            buf[cmdline.length()] = 0;
+            Timer timer;
+            if (params.parse(&buf[0], cmdline.length(), CMDLINE_POSIX)) parsed++;
+            totalMs += timer.elapsedMs();
+        }
+        keep(parsed);
+        const double megabytes = (double)cmdline.length() / (1024 * 1024);
+        report("Params::parse, POSIX", megabytes * rounds / (totalMs / 1000), "MB/s");
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    std::cout << "tokenizing " << (INPUT_SIZE / (1024 * 1024)) << " MB command lines:\n";
+    bench_style<char>(CMDLINE_WINDOWS, "Windows rules, char");
+    bench_style<wchar_t>(CMDLINE_WINDOWS, "Windows rules, wchar_t");
+    bench_style<char>(CMDLINE_POSIX, "POSIX rules, char");
+    bench_style<wchar_t>(CMDLINE_POSIX, "POSIX rules, wchar_t");
+    bench_style<char>(CMDLINE_NUL_SEPARATED, "NUL separated, char");
+    bench_parse();
+    return 0;
+}
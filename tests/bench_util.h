@@ -0,0 +1,46 @@
+/**
+* @file
+* @brief   Minimal helpers of the benchmarks: measuring the time, and preventing the measured results from being optimized out
+*/
+
+#pragma once
+
+#include <iostream>
+#include <chrono>
+
+namespace paramkit_bench {
+
+    typedef std::chrono::steady_clock bench_clock;
+
+    //! Measures the time elapsed since its creation
+    class Timer {
+    public:
+        Timer()
+            : start(bench_clock::now())
+        {
+        }
+
+        double elapsedMs() const
+        {
+            return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+        }
+
+    protected:
+        bench_clock::time_point start;
+    };
+
+    //! Consumes the value, so that the computation of it can't be removed by the compiler
+    template <typename T>
+    inline void keep(const T &value)
+    {
+        static volatile size_t sink = 0;
+        sink = sink + (size_t)value;
+    }
+
+    //! Prints the result as: name: value unit
+    inline void report(const std::string &name, double value, const char *unit)
+    {
+        std::cout << name << ": " << value << " " << unit << "\n";
+    }
+
+}; //namespace paramkit_bench
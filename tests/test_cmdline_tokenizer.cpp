@@ -0,0 +1,189 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    //! Splits the command line, returning the arguments joined with '|'
+    std::string split(const std::string &cmdLine, t_cmdline_style style, bool withProgramName = false)
+    {
+        std::string buf = cmdLine;
+        CmdlineTokenizer<char> tokenizer(&buf[0], buf.length(), style);
+        std::vector<char*> args;
+        if (!withProgramName) {
+            tokenizer.next();
+        }
+        tokenizer.tokenize(args);
+
+        std::string joined;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (i) joined += "|";
+            joined += args[i];
+        }
+        return joined;
+    }
+
+    void test_windows()
+    {
+        const t_cmdline_style style = CMDLINE_WINDOWS;
+        CHECK(split("prog a b\tc", style) == "a|b|c");
+        CHECK(split("prog \"a b\" c", style) == "a b|c");
+        CHECK(split("prog \"\" x", style) == "|x");
+        // the backslashes are literal, unless they precede a quote:
+        CHECK(split("prog a\\\\b \\\"q\\\" \"c\\\\\" d", style) == "a\\\\b|\"q\"|c\\|d");
+        CHECK(split("prog a\\\\\\\"b", style) == "a\\\"b");
+        // the doubled quote inside the quoted part gives a quote, and the quoted part continues:
+        CHECK(split("prog \"a\"\"b c\" d", style) == "a\"b c|d");
+        // only the spaces and tabs are the separators:
+        CHECK(split("prog a\nb c\r", style) == "a\nb|c\r");
+        // the program name: the backslashes are literal
+        CHECK(split("\"C:\\Program Files\\x.exe\" a", style, true) == "C:\\Program Files\\x.exe|a");
+        CHECK(split("C:\\dir\\x.exe a\\\"b", style, true) == "C:\\dir\\x.exe|a\"b");
+    }
+
+    void test_posix()
+    {
+        const t_cmdline_style style = CMDLINE_POSIX;
+        CHECK(split("prog a\nb\r\nc", style) == "a|b|c");
+        CHECK(split("prog 'a \"b' \"c 'd\" e\\ f", style) == "a \"b|c 'd|e f");
+        CHECK(split("prog \"a\\\"b\\$c\\x\"", style) == "a\"b$c\\x");
+        CHECK(split("prog a\\\nb \\\n c", style) == "ab|c");
+        CHECK(split("prog '' \"\" x", style) == "||x");
+    }
+
+    void test_nul_separated()
+    {
+        const std::string cmdLine("prog\0a b\0\0c", 11);
+        CHECK(split(cmdLine, CMDLINE_NUL_SEPARATED) == "a b||c");
+    }
+
+    //! The response files: with the Windows rules, each line is split separately
+    void test_response_file()
+    {
+        const char *path = "test_cmdline_tokenizer.rsp";
+        FILE *fp = fopen(path, "wb");
+        CHECK(fp != nullptr);
+        if (!fp) return;
+        const char content[] = "\xEF\xBB\xBF" "a \"b c\r\n\r\n  d\"\"e\n\"f\"";
+        fwrite(content, 1, sizeof(content) - 1, fp);
+        fclose(fp);
+
+        std::string rspArg = std::string("@") + path;
+        char prog[] = "prog";
+        char *argv[] = { prog, &rspArg[0] };
+        const t_cmdline_style styles[] = { CMDLINE_WINDOWS, CMDLINE_POSIX };
+        const char *expected[] = { "a|b c|de|f", "a|b c\r\n\r\n  de\nf" };
+        for (size_t i = 0; i < 2; i++) {
+            ArgsStream<char> args(2, argv, true, styles[i]);
+            std::string joined;
+            const char *arg = nullptr;
+            while ((arg = args.next()) != nullptr) {
+                if (joined.length()) joined += "|";
+                joined += arg;
+                CHECK(args.argIndex() == 1);
+            }
+            if (joined != expected[i]) {
+                std::cerr << "style " << styles[i] << ": " << joined << "\n";
+            }
+            CHECK(joined == expected[i]);
+        }
+        remove(path);
+    }
+
+    void test_utf8()
+    {
+        std::wstring out;
+        const char valid[] = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+        util::append_utf8(valid, sizeof(valid) - 1, out);
+        std::wstring expected = L"a\u00E9\u20AC";
+        if (sizeof(wchar_t) == 2) {
+            expected += (wchar_t)0xD83D;
+            expected += (wchar_t)0xDE00;
+        }
+        else {
+            expected += (wchar_t)0x1F600;
+        }
+        CHECK(out == expected);
+
+        // truncated, overlong, surrogate, and out of range:
+        const char invalid[] = "\xC3" "b" "\xC0\x80" "\xED\xA0\x80" "\xF4\x90\x80\x80";
+        out.clear();
+        util::append_utf8(invalid, sizeof(invalid) - 1, out);
+        CHECK(out.length() == 11);
+        CHECK(out[0] == 0xFFFD && out[1] == L'b' && out[2] == 0xFFFD && out[10] == 0xFFFD);
+    }
+
+    //! The wide arguments read from the response file are decoded from UTF-8
+    void test_response_file_wide()
+    {
+        const char *path = "test_cmdline_tokenizer_w.rsp";
+        FILE *fp = fopen(path, "wb");
+        CHECK(fp != nullptr);
+        if (!fp) return;
+        const char content[] = "\xC5\xBC\xC3\xB3\xC5\x82w \"a \xE2\x82\xAC\"";
+        fwrite(content, 1, sizeof(content) - 1, fp);
+        fclose(fp);
+
+        std::wstring rspArg = L"@test_cmdline_tokenizer_w.rsp";
+        wchar_t prog[] = L"prog";
+        wchar_t *argv[] = { prog, &rspArg[0] };
+        ArgsStream<wchar_t> args(2, argv, true, CMDLINE_POSIX);
+        const wchar_t *arg = args.next();
+        CHECK(arg && std::wstring(arg) == L"\u017C\u00F3\u0142w");
+        arg = args.next();
+        CHECK(arg && std::wstring(arg) == L"a \u20AC");
+        CHECK(args.next() == nullptr);
+        remove(path);
+    }
+
+    //! The response file with the non-ASCII name is found by its wide path
+    void test_response_file_wide_path()
+    {
+        const std::wstring path = L"test_cmdline_tokenizer_\u017C\u00F3\u0142w.rsp";
+#ifdef _WIN32
+        FILE *fp = _wfopen(path.c_str(), L"wb");
+#else
+        const char utf8Path[] = "test_cmdline_tokenizer_\xC5\xBC\xC3\xB3\xC5\x82w.rsp";
+        FILE *fp = fopen(utf8Path, "wb");
+#endif
+        CHECK(fp != nullptr);
+        if (!fp) return;
+        const char content[] = "/name value";
+        fwrite(content, 1, sizeof(content) - 1, fp);
+        fclose(fp);
+
+        std::wstring rspArg = L"@" + path;
+        wchar_t prog[] = L"prog";
+        wchar_t *argv[] = { prog, &rspArg[0] };
+        ArgsStream<wchar_t> args(2, argv, true, CMDLINE_POSIX);
+        const wchar_t *arg = args.next();
+        CHECK(arg && std::wstring(arg) == L"/name");
+        arg = args.next();
+        CHECK(arg && std::wstring(arg) == L"value");
+        CHECK(args.next() == nullptr);
+#ifdef _WIN32
+        _wremove(path.c_str());
+#else
+        remove(utf8Path);
+#endif
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_windows();
+    test_posix();
+    test_nul_separated();
+    test_response_file();
+    test_utf8();
+    test_response_file_wide();
+    test_response_file_wide_path();
+    return paramkit_test::summary("test_cmdline_tokenizer");
+}
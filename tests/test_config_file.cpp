@@ -0,0 +1,137 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    //! Collects the entries, as: key=value, or the key alone if the value is null
+    class EntriesCollector : public util::ConfigHandler {
+    public:
+        EntriesCollector(const std::string &_delimiter = ",")
+            : delimiter(_delimiter)
+        {
+        }
+
+        virtual bool onEntry(const util::StringView &key, const char *value, std::string &/*errorMsg*/)
+        {
+            std::string entry = key.str();
+            if (value) entry += "=" + std::string(value);
+            entries.push_back(entry);
+            return true;
+        }
+
+        virtual std::string listDelimiter(const util::StringView &/*key*/)
+        {
+            return delimiter;
+        }
+
+        std::string delimiter;
+        std::vector<std::string> entries;
+    };
+
+    bool read(const std::string &content, t_config_format format, EntriesCollector &collector, std::vector<ConfigError> &errors)
+    {
+        util::ConfigReader reader(content.c_str(), content.length(), format);
+        return reader.read(collector, errors);
+    }
+
+    void test_ini()
+    {
+        EntriesCollector collector;
+        std::vector<ConfigError> errors;
+        const std::string content =
+            "; comment\n"
+            "[section]\n"
+            "a = 1 ; the inline comment\n"
+            "b = x;y#z\n"
+            "c = ;empty\n"
+            "d = \"quoted ; text\" # comment\n"
+            "e\n";
+        CHECK(read(content, CONFIG_INI, collector, errors));
+        CHECK(errors.empty());
+        const char *expected[] = { "a=1", "b=x;y#z", "c=", "d=quoted ; text", "e" };
+        CHECK(collector.entries == std::vector<std::string>(expected, expected + 5));
+    }
+
+    void test_json_strings()
+    {
+        EntriesCollector collector;
+        std::vector<ConfigError> errors;
+        CHECK(read("{\"a\": \"x\\u00e9\\ud83d\\ude00\", \"b\": null, \"c\": 5}", CONFIG_JSON, collector, errors));
+        const char *expected[] = { "a=x\xC3\xA9\xF0\x9F\x98\x80", "b", "c=5" };
+        CHECK(collector.entries == std::vector<std::string>(expected, expected + 3));
+
+        // the lone surrogates, and the NUL character, are rejected:
+        const char *invalid[] = {
+            "{\"a\": \"\\ud83d\"}",
+            "{\"a\": \"\\ud83dx\"}",
+            "{\"a\": \"\\ud83d\\u0041\"}",
+            "{\"a\": \"\\ude00\"}",
+            "{\"a\": \"x\\u0000y\"}"
+        };
+        for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+            EntriesCollector rejecting;
+            errors.clear();
+            CHECK(!read(invalid[i], CONFIG_JSON, rejecting, errors));
+            CHECK(errors.size() == 1);
+            CHECK(rejecting.entries.empty());
+        }
+    }
+
+    void test_json_arrays()
+    {
+        std::vector<ConfigError> errors;
+        EntriesCollector semicolon(";");
+        CHECK(read("{\"a\": [1, \"x,y\", true], \"b\": []}", CONFIG_JSON, semicolon, errors));
+        CHECK(semicolon.entries.size() == 2);
+        CHECK(semicolon.entries[0] == "a=1;x,y;true");
+
+        // the element containing the delimiter would not be parsed as a single one:
+        EntriesCollector comma(",");
+        CHECK(!read("{\"a\": [\"x,y\"]}", CONFIG_JSON, comma, errors));
+        CHECK(comma.entries.empty());
+
+        // without the delimiter, only a single element is allowed:
+        EntriesCollector none("");
+        errors.clear();
+        CHECK(read("{\"a\": [\"x,y\"]}", CONFIG_JSON, none, errors));
+        CHECK(!read("{\"a\": [1, 2]}", CONFIG_JSON, none, errors));
+        CHECK(none.entries.size() == 1 && none.entries[0] == "a=x,y");
+    }
+
+    //! The arrays are joined with the delimiter of the target parameter
+    void test_params()
+    {
+        Params params;
+        StringListParam *list = new StringListParam("list", false, ';');
+        StringParam *name = new StringParam("name", false);
+        params.addParam(list);
+        params.addParam(name);
+
+        std::vector<ConfigError> errors;
+        const std::string content = "{\"list\": [\"a,b\", \"c\"], \"name\": [\"single\"]}";
+        CHECK(params.loadConfig(content.c_str(), content.length(), errors, CONFIG_JSON));
+        CHECK(list->value == "a,b;c");
+        CHECK(name->value == "single");
+
+        const std::string multiple = "{\"name\": [\"a\", \"b\"]}";
+        CHECK(!params.loadConfig(multiple.c_str(), multiple.length(), errors, CONFIG_JSON));
+        CHECK(name->value == "single");
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_ini();
+    test_json_strings();
+    test_json_arrays();
+    test_params();
+    return paramkit_test::summary("test_config_file");
+}
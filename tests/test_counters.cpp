@@ -0,0 +1,217 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    //! Exposes the parameters and the groups
+    class CountedParams : public Params {
+    public:
+        Param* get(const std::string &name)
+        {
+            return getParam(name);
+        }
+
+        ParamGroup* group(const std::string &name)
+        {
+            return getParamGroup(name);
+        }
+    };
+
+    //! A parameter which activity depends on another parameter
+    class DependentParam : public IntParam {
+    public:
+        DependentParam(const std::string &name, const BoolParam &_enabler)
+            : IntParam(name, true), enabler(_enabler)
+        {
+        }
+
+        virtual bool isActive() const
+        {
+            return enabler.isSet();
+        }
+
+    protected:
+        const BoolParam &enabler;
+    };
+
+    //! A parameter that reports its destruction
+    class TrackedParam : public IntParam {
+    public:
+        TrackedParam(const std::string &name, bool isRequired, bool &_isDeleted)
+            : IntParam(name, isRequired), isDeleted(_isDeleted)
+        {
+            isDeleted = false;
+        }
+
+        virtual ~TrackedParam()
+        {
+            isDeleted = true;
+        }
+
+    protected:
+        bool &isDeleted;
+    };
+
+    //! The counters follow the parameters that are added, set, and deactivated
+    void test_counters()
+    {
+        CountedParams params;
+        params.addParam(new IntParam("req1", true));
+        params.addParam(new IntParam("req2", true));
+        params.addParam(new IntParam("opt1", false));
+        params.addParam(new BoolParam("opt2", false));
+
+        const ParamCounters &counters = params.getCounters();
+        CHECK(counters.countTotal(true) == 2);
+        CHECK(counters.countTotal(false) == 2);
+        CHECK(counters.countFilled(true) == 0);
+        CHECK(counters.countActive(true) == 2);
+        CHECK(counters.countMissing(true) == 2);
+
+        CHECK(params.setIntValue("req1", 1));
+        CHECK(counters.countFilled(true) == 1);
+        CHECK(counters.countMissing(true) == 1);
+
+        params.get("opt1")->setActive(false);
+        CHECK(counters.countActive(false) == 1);
+        CHECK(params.group("")->getCounters().countActive(false) == 1);
+
+        // the direct changes are counted after the update:
+        CHECK(params.get("opt2")->parse((char*)nullptr));
+        CHECK(counters.countFilled(false) == 0);
+        params.updateCounters("opt2");
+        CHECK(counters.countFilled(false) == 1);
+    }
+
+    //! The missing required parameters are tracked in the bitset, also beyond its first word
+    void test_missing_required()
+    {
+        CountedParams params;
+        const size_t count = 130;
+        for (size_t i = 0; i < count; i++) {
+            params.addParam(new IntParam("param" + std::to_string(i), (i % 2) == 0));
+        }
+        std::vector<std::string> missing;
+        CHECK(!params.hasRequiredFilled());
+        CHECK(params.listMissingRequired(missing) == count / 2);
+        CHECK(missing.size() == count / 2 && missing[0] == "param0" && missing.back() == "param128");
+
+        for (size_t i = 0; i < count; i += 2) {
+            if (i == 128) continue;
+            params.setIntValue("param" + std::to_string(i), i);
+        }
+        missing.clear();
+        CHECK(params.listMissingRequired(missing) == 1);
+        CHECK(missing.size() == 1 && missing[0] == "param128");
+        CHECK(!params.hasRequiredFilled());
+
+        params.get("param128")->setActive(false);
+        CHECK(params.hasRequiredFilled());
+        params.get("param128")->setActive(true);
+        CHECK(!params.hasRequiredFilled());
+        params.setIntValue("param128", 1);
+        CHECK(params.hasRequiredFilled());
+    }
+
+    //! The required parameters changed without the notification are re-checked
+    void test_direct_changes()
+    {
+        CountedParams params;
+        IntParam *parsed = new IntParam("parsed", true);
+        IntParam *assigned = new IntParam("assigned", true);
+        params.addParam(parsed);
+        params.addParam(assigned);
+        CHECK(!params.hasRequiredFilled());
+
+        // parsed directly:
+        CHECK(parsed->parse("5"));
+        std::vector<std::string> missing;
+        CHECK(params.listMissingRequired(missing) == 1 && missing[0] == "assigned");
+
+        // assigned directly:
+        assigned->value = 10;
+        CHECK(params.hasRequiredFilled());
+        CHECK(params.getCounters().countFilled(true) == 2);
+
+        // reset directly:
+        assigned->value = PARAM_UNINITIALIZED;
+        CHECK(!params.hasRequiredFilled());
+    }
+
+    //! The activity of the parameter can change along with the other parameter
+    void test_overridden_active()
+    {
+        CountedParams params;
+        BoolParam *enabler = new BoolParam("enable", false);
+        params.addParam(enabler);
+        params.addParam(new DependentParam("dependent", *enabler));
+        CHECK(params.hasRequiredFilled());
+
+        const char *argv[] = { "prog", "/enable" };
+        CHECK(!params.parse(2, const_cast<char**>(argv)));
+        std::vector<std::string> missing;
+        CHECK(params.listMissingRequired(missing) == 1 && missing[0] == "dependent");
+
+        // the same with the external store:
+        ParsedValues values;
+        CHECK(params.parseInto(2, const_cast<char**>(argv), values) == false);
+        const char *argv2[] = { "prog", "/enable", "/dependent", "1" };
+        CHECK(params.parseInto(4, const_cast<char**>(argv2), values));
+        CHECK(values.countRequiredFilled() == 1);
+    }
+
+    //! The parameter added with the name of an existing one replaces it completely
+    void test_replace()
+    {
+        CountedParams params;
+        params.addGroup(new ParamGroup("Group"));
+        bool isDeleted = false;
+        params.addParam(new TrackedParam("dup", true, isDeleted));
+        params.addParam(new IntParam("other", false));
+        CHECK(params.addParamToGroup("dup", "Group"));
+        const size_t id = params.getParamId("dup");
+
+        IntParam *replacement = new IntParam("dup", false);
+        params.addParam(replacement);
+        CHECK(isDeleted);
+        CHECK(params.get("dup") == replacement);
+        CHECK(params.getParamId("dup") == id);
+
+        // the counters don't include the replaced parameter:
+        CHECK(params.getCounters().countTotal(true) == 0);
+        CHECK(params.getCounters().countTotal(false) == 2);
+        CHECK(params.hasRequiredFilled());
+
+        // the replaced parameter is removed from its group, and the new one is added to the general group:
+        CHECK(params.group("Group")->getCounters().countTotal(true) == 0);
+        CHECK(params.group("")->getCounters().countTotal(false) == 2);
+        CHECK(params.addParamToGroup("dup", "Group"));
+        CHECK(params.group("Group")->getCounters().countTotal(false) == 1);
+        CHECK(params.group("")->getCounters().countTotal(false) == 1);
+
+        const std::string info = params.infoToString();
+        CHECK(info.find("/dup <") != std::string::npos && info.find("/dup <") == info.rfind("/dup <"));
+
+        // adding the same parameter again doesn't change anything:
+        params.addParam(replacement);
+        CHECK(params.get("dup") == replacement);
+        CHECK(params.getCounters().countTotal(false) == 2);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_counters();
+    test_missing_required();
+    test_direct_changes();
+    test_overridden_active();
+    test_replace();
+    return paramkit_test::summary("test_counters");
+}
@@ -0,0 +1,107 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    const t_scan_impl g_impls[] = { SCAN_IMPL_SCALAR, SCAN_IMPL_SSE2, SCAN_IMPL_AVX2, SCAN_IMPL_AUTO };
+    const size_t g_implsCount = sizeof(g_impls) / sizeof(g_impls[0]);
+
+    //! Checks that all the available implementations agree with the scalar one
+    void check_agreement(const std::string &str, int expected)
+    {
+        for (size_t i = 0; i < g_implsCount; i++) {
+            int flags = (-1);
+            if (!scan_digits_with(g_impls[i], str.data(), str.length(), flags)) {
+                continue; // not supported here
+            }
+            if (flags != expected) {
+                std::cerr << "impl " << g_impls[i] << ", len " << str.length() << ": " << flags << " != " << expected << "\n";
+            }
+            CHECK(flags == expected);
+        }
+    }
+
+    //! All the lengths around the widths of the vectors: the tails are handled by the narrower kernels
+    void test_lengths()
+    {
+        for (size_t len = 1; len <= 100; len++) {
+            check_agreement(std::string(len, '7'), DIGITS_DEC | DIGITS_HEX);
+            check_agreement(std::string(len, 'c'), DIGITS_HEX);
+            std::string mixed(len, '1');
+            mixed[len - 1] = 'F';
+            check_agreement(mixed, DIGITS_HEX);
+        }
+    }
+
+    //! A non-digit byte at every position (i.e. at every lane of the vectors, and in the tails)
+    void test_invalid_at_every_lane()
+    {
+        const unsigned char invalid[] = { 'g', 'G', 'x', '/', ':', '@', '`', ' ', 0, 0x80, 0xB0, 0xFF, '0' - 1, '9' + 1, 'a' - 1, 'f' + 1, 'A' - 1, 'F' + 1 };
+        const size_t lens[] = { 15, 16, 17, 31, 32, 33, 64, 70 };
+        for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+            for (size_t pos = 0; pos < lens[l]; pos++) {
+                for (size_t k = 0; k < sizeof(invalid); k++) {
+                    std::string str(lens[l], '5');
+                    str[pos] = (char)invalid[k];
+                    check_agreement(str, DIGITS_NONE);
+                }
+                // a hex letter at every lane clears only the decimal flag:
+                std::string hexStr(lens[l], '5');
+                hexStr[pos] = 'e';
+                check_agreement(hexStr, DIGITS_HEX);
+            }
+        }
+    }
+
+    //! The full byte range, each byte in a vector-sized buffer
+    void test_all_bytes()
+    {
+        for (int c = 0; c < 256; c++) {
+            std::string str(40, '0');
+            str[33] = (char)c;
+            int expected = 0;
+            CHECK(scan_digits_with(SCAN_IMPL_SCALAR, str.data(), str.length(), expected));
+            check_agreement(str, expected);
+        }
+    }
+
+    void test_load_number()
+    {
+        uint64_t val = 0;
+        CHECK(load_number("18446744073709551615", val) && val == UINT64_MAX);
+        CHECK(!load_number("18446744073709551616", val));
+        CHECK(load_number("0xFFFFFFFFFFFFFFFF", val) && val == UINT64_MAX);
+        CHECK(load_number("0x0000000000000000000000ff", val) && val == 0xff); // the leading zeros
+        CHECK(!load_number("0x10000000000000000", val));
+        CHECK(load_number("0123456789abcdef", val, NUM_BASE_HEX) && val == 0x0123456789abcdefULL);
+        CHECK(!load_number("0123456789abcdeg", val, NUM_BASE_HEX));
+        CHECK(!load_number("12a", val));
+        CHECK(!load_number("0x", val));
+        CHECK(!load_number("", val));
+        CHECK(!load_number("0x10", val, NUM_BASE_DEC));
+        CHECK(load_number("10", val, NUM_BASE_HEX) && val == 0x10);
+        // the length-bounded variant doesn't read past the given length:
+        CHECK(load_number("1234xyz", 4, val) && val == 1234);
+
+        // the same results for the narrow and the wide strings:
+        const wchar_t *wide = L"0xdeadBEEF";
+        CHECK(load_number(wide, val) && val == 0xdeadbeefULL);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_lengths();
+    test_invalid_at_every_lane();
+    test_all_bytes();
+    test_load_number();
+    return paramkit_test::summary("test_digits_scan");
+}
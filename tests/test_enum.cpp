@@ -0,0 +1,161 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    enum class t_fruits {
+        FRUIT_APPLE = 0,
+        FRUIT_ORANGE = 1,
+        FRUIT_PEAR = 5
+    };
+
+    enum t_plain {
+        PLAIN_ONE = 1,
+        PLAIN_TWO = 2
+    };
+
+    //! Parses the argument, and returns the value of the parameter
+    int parsed_value(EnumParam &param, const char *arg, bool &isParsed)
+    {
+        isParsed = param.parse(arg);
+        return param.value;
+    }
+
+    //! The scope and the given prefix are stripped from the names defined by ENUM_VALUE_DEF
+    void test_definitions()
+    {
+        const EnumValueDef fruits[] = {
+            ENUM_VALUE_DEF(t_fruits::FRUIT_APPLE, "green apples"),
+            ENUM_VALUE_DEF(t_fruits::FRUIT_ORANGE, "oranges"),
+            ENUM_VALUE_DEF(t_fruits::FRUIT_PEAR, "pears")
+        };
+        EnumParam param("fruit", "fruits", false);
+        CHECK(param.addEnumValues(fruits, "FRUIT_") == 3);
+
+        bool isParsed = false;
+        CHECK(parsed_value(param, "ORANGE", isParsed) == (int)t_fruits::FRUIT_ORANGE && isParsed);
+        CHECK(param.valToString() == "ORANGE");
+        CHECK(parsed_value(param, "PEAR", isParsed) == (int)t_fruits::FRUIT_PEAR && isParsed);
+        CHECK(!param.parse("FRUIT_PEAR"));
+        CHECK(!param.parse("t_fruits::FRUIT_PEAR"));
+
+        // the numbers are accepted only within the enum:
+        CHECK(parsed_value(param, "1", isParsed) == 1 && isParsed);
+        CHECK(!param.parse("2"));
+
+        // without the prefix to strip, only the scope is removed; the names are optional:
+        const EnumValueDef plain[] = {
+            ENUM_VALUE_DEF(PLAIN_ONE, "one"),
+            { PLAIN_TWO, nullptr, "two" }
+        };
+        EnumParam plainParam("plain", "plain", false);
+        CHECK(plainParam.addEnumValues(plain) == 2);
+        CHECK(parsed_value(plainParam, "PLAIN_ONE", isParsed) == PLAIN_ONE && isParsed);
+        CHECK(parsed_value(plainParam, "2", isParsed) == PLAIN_TWO && isParsed);
+        CHECK(plainParam.valToString() == "2");
+    }
+
+    //! The later definitions of the same value replace the earlier ones, as if the values were added one by one
+    void test_redefinitions()
+    {
+        EnumParam param("mode", "modes", false);
+        param.addEnumValue(1, "old", "the old name");
+        param.addEnumValue(2, "kept", "the kept name");
+
+        const EnumValueDef defs[] = {
+            { 1, "new", "the new name" },
+            { 2, nullptr, "the new info" },
+            { 3, "first", "the first definition" },
+            { 3, "second", "the second definition" }
+        };
+        CHECK(param.addEnumValues(defs) == 4);
+        CHECK(!param.parse("old"));
+        CHECK(param.parse("new") && param.value == 1);
+        CHECK(param.parse("kept") && param.value == 2);
+        CHECK(!param.parse("first"));
+        CHECK(param.parse("second") && param.value == 3);
+
+        const std::string info = param.info(true);
+        CHECK(info.find("the new info") != std::string::npos);
+        CHECK(info.find("the second definition") != std::string::npos);
+        CHECK(info.find("the first definition") == std::string::npos);
+
+        // the single replacement:
+        param.addEnumValue(3, "third", "the third definition");
+        CHECK(!param.parse("second"));
+        CHECK(param.parse("third") && param.value == 3);
+    }
+
+    //! The names are matched case sensitive by default
+    void test_case_sensitivity()
+    {
+        EnumParam param("color", "colors", false);
+        param.addEnumValue(0, "Red", "red");
+        param.addEnumValue(1, "green", "green");
+        param.addEnumValue(2, "BLUE", "blue");
+
+        CHECK(param.parse("Red") && param.value == 0);
+        CHECK(!param.parse("red"));
+        CHECK(!param.parse("Blue"));
+
+        param.setCaseSensitive(false);
+        CHECK(param.parse("red") && param.value == 0);
+        CHECK(param.parse("GREEN") && param.value == 1);
+        CHECK(param.parse("blue") && param.value == 2);
+        CHECK(!param.parse("blu"));
+
+        // the values added after the change are matched the same way:
+        param.addEnumValue(3, "Yellow", "yellow");
+        CHECK(param.parse("YELLOW") && param.value == 3);
+
+        param.setCaseSensitive(true);
+        CHECK(!param.parse("YELLOW"));
+        CHECK(param.parse("Yellow") && param.value == 3);
+    }
+
+    //! The big enums are found by the name, also case insensitive
+    void test_big_enum()
+    {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < 500; i++) {
+            names.push_back("NtSyscall" + std::to_string(i));
+        }
+        std::vector<EnumValueDef> defs;
+        for (size_t i = 0; i < names.size(); i++) {
+            // added in the reversed order:
+            const size_t id = names.size() - 1 - i;
+            EnumValueDef def = { (int)id, names[id].c_str(), "a system call" };
+            defs.push_back(def);
+        }
+        EnumParam param("syscall", "syscalls", false);
+        CHECK(param.addEnumValues(&defs[0], defs.size()) == defs.size());
+        param.setCaseSensitive(false);
+
+        bool allFound = true;
+        for (size_t i = 0; i < names.size(); i++) {
+            std::string lower = names[i];
+            lower[0] = 'n';
+            lower[1] = 'T';
+            if (!param.parse(lower.c_str()) || param.value != (int)i) allFound = false;
+        }
+        CHECK(allFound);
+        CHECK(!param.parse("NtSyscall500"));
+        CHECK(param.parse("499") && param.value == 499);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_definitions();
+    test_redefinitions();
+    test_case_sensitivity();
+    test_big_enum();
+    return paramkit_test::summary("test_enum");
+}
@@ -0,0 +1,65 @@
+#include <paramkit.h>
+
+#include <string>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    void test_parse()
+    {
+        FlagsParam param("flags", "t_access", false);
+        CHECK(param.addFlag(0, "read", "Read access"));
+        CHECK(param.addFlag(1, "write", "Write access"));
+        CHECK(param.addFlag(63, "exec", "Execute access"));
+        CHECK(!param.addFlag(64, "invalid", "Out of range"));
+        CHECK(param.validFlags() == (FlagsParam::flagMask(0) | FlagsParam::flagMask(1) | FlagsParam::flagMask(63)));
+
+        CHECK(param.parse("read | exec"));
+        CHECK(param.hasFlag(0) && !param.hasFlag(1) && param.hasFlag(63));
+        CHECK(param.valToString() == "read|exec");
+
+        // the numbers are accepted, if they contain only the defined flags:
+        CHECK(param.parse("0x2|read"));
+        CHECK(param.flags == 3);
+        CHECK(!param.parse("0x4"));
+        CHECK(!param.parse("read|unknown"));
+        CHECK(!param.parse("|"));
+        CHECK(!param.parse(""));
+        CHECK(param.flags == 3);
+    }
+
+    //! The values added by the generic methods of the enum are also valid flags
+    void test_valid_flags_update()
+    {
+        FlagsParam param("flags", "t_opts", false, ',');
+        CHECK(param.validFlags() == 0);
+        CHECK(!param.parse("0x1"));
+        param.addEnumValue(2, "two", "The third bit");
+        CHECK(param.validFlags() == 4);
+        CHECK(param.parse("two,0x4"));
+        CHECK(param.flags == 4);
+    }
+
+    //! The NUL delimiter would make the parser read past the end of the string: the default is used instead
+    void test_nul_delimiter()
+    {
+        FlagsParam param("flags", "t_opts", false, '\0');
+        CHECK(param.delimiter == '|');
+        param.addFlag(0, "a", "A");
+        param.addFlag(1, "b", "B");
+        CHECK(param.parse("a|b"));
+        CHECK(param.flags == 3);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_parse();
+    test_valid_flags_update();
+    test_nul_delimiter();
+    return paramkit_test::summary("test_flags");
+}
@@ -0,0 +1,99 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <climits>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    std::vector<uint64_t> to_vector(const util::Span<uint64_t> &span)
+    {
+        return std::vector<uint64_t>(span.begin(), span.end());
+    }
+
+    void test_parse()
+    {
+        IntListParam param("list", false, ",");
+        CHECK(param.parse("1, 0x10,3-5 ,,2"));
+        const uint64_t expected[] = { 1, 0x10, 3, 4, 5, 2 };
+        CHECK(to_vector(param.getNumbers()) == std::vector<uint64_t>(expected, expected + 6));
+        CHECK(param.contains(4) && !param.contains(6));
+
+        // the invalid lists don't change the parsed value:
+        CHECK(!param.parse("1,x"));
+        CHECK(!param.parse("5-3"));
+        CHECK(!param.parse(""));
+        CHECK(!param.parse(",,"));
+        CHECK(param.getNumbers().size() == 6);
+
+        CHECK(param.parse("18446744073709551614-0xffffffffffffffff"));
+        CHECK(param.getNumbers().size() == 2);
+        CHECK(!param.parse("18446744073709551616"));
+    }
+
+    void test_order()
+    {
+        IntListParam param("list", false, ";");
+        param.setOrder(false, true);
+        CHECK(param.parse("5;1;5;2-4;1"));
+        const uint64_t firstOccurrences[] = { 5, 1, 2, 3, 4 };
+        CHECK(to_vector(param.getNumbers()) == std::vector<uint64_t>(firstOccurrences, firstOccurrences + 5));
+
+        param.setOrder(true, false);
+        CHECK(param.parse("5;1;5"));
+        const uint64_t sorted[] = { 1, 5, 5 };
+        CHECK(to_vector(param.getNumbers()) == std::vector<uint64_t>(sorted, sorted + 3));
+    }
+
+    //! Both a single range, and the whole list, are limited
+    void test_limits()
+    {
+        IntListParam param("list", false, ",");
+        const std::string maxRange = "0-" + std::to_string(INT_LIST_RANGE_MAX - 1);
+        CHECK(param.parse(maxRange.c_str()));
+        CHECK(param.getNumbers().size() == INT_LIST_RANGE_MAX);
+        CHECK(!param.parse(("0-" + std::to_string(INT_LIST_RANGE_MAX)).c_str()));
+
+        const size_t rangesCount = INT_LIST_COUNT_MAX / INT_LIST_RANGE_MAX;
+        std::string list;
+        for (size_t i = 0; i < rangesCount; i++) {
+            if (i) list += ",";
+            list += maxRange;
+        }
+        CHECK(param.parse(list.c_str()));
+        CHECK(param.getNumbers().size() == INT_LIST_COUNT_MAX);
+        CHECK(!param.parse((list + ",1").c_str()));
+        CHECK(!param.parse(("1," + list).c_str()));
+    }
+
+    //! The legacy getter parses the current value, also if it was assigned directly
+    void test_strip_to_elements()
+    {
+        IntListParam param("list", false, ",");
+        CHECK(param.parse("1,2"));
+        param.value = "7,x,3-4,0xffffffffffffffff";
+
+        std::set<long> asLong;
+        CHECK(param.stripToIntElements(asLong) == 3);
+        CHECK(asLong.count(7) && asLong.count(3) && asLong.count(4));
+
+        std::set<uint64_t> full;
+        CHECK(param.stripToIntElements(full) == 4);
+        CHECK(full.count(0xffffffffffffffffULL) == 1);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_parse();
+    test_order();
+    test_limits();
+    test_strip_to_elements();
+    return paramkit_test::summary("test_int_list");
+}
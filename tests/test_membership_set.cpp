@@ -0,0 +1,140 @@
+#include <paramkit.h>
+
+#include <vector>
+#include <set>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    typedef util::MembershipSet MembershipSet;
+
+    //! Compares the answers of the set with the reference, for all the values, their neighbours, and the bounds
+    bool matches_reference(const MembershipSet &set, const std::vector<uint64_t> &values)
+    {
+        const std::set<uint64_t> reference(values.begin(), values.end());
+        if (set.size() != reference.size()) return false;
+
+        std::vector<uint64_t> queries;
+        queries.push_back(0);
+        queries.push_back(1);
+        queries.push_back((uint64_t)(-1));
+        for (size_t i = 0; i < values.size(); i++) {
+            queries.push_back(values[i]);
+            queries.push_back(values[i] - 1);
+            queries.push_back(values[i] + 1);
+        }
+        for (size_t i = 0; i < queries.size(); i++) {
+            const bool expected = reference.find(queries[i]) != reference.end();
+            if (set.contains(queries[i]) != expected) return false;
+        }
+        return true;
+    }
+
+    //! The sparse values: too far from each other for the bitmap
+    std::vector<uint64_t> sparse_values(size_t count, uint64_t start = 1000)
+    {
+        std::vector<uint64_t> values;
+        for (size_t i = 0; i < count; i++) {
+            values.push_back(start + i * 1000000007ULL);
+        }
+        return values;
+    }
+
+    void test_empty()
+    {
+        MembershipSet set;
+        CHECK(set.getKind() == MembershipSet::SET_EMPTY);
+        CHECK(!set.contains(0));
+
+        set.build(nullptr, 0);
+        CHECK(set.getKind() == MembershipSet::SET_EMPTY && set.size() == 0);
+    }
+
+    //! The dense values are kept in the bitmap
+    void test_bitmap()
+    {
+        std::vector<uint64_t> values;
+        for (uint64_t i = 100; i < 300; i++) {
+            if (i % 3 == 0) continue;
+            values.push_back(i);
+        }
+        values.push_back(150); // a duplicate
+        MembershipSet set;
+        set.build(values);
+        CHECK(set.getKind() == MembershipSet::SET_BITMAP);
+        CHECK(matches_reference(set, values));
+
+        // the bitmap starting at zero:
+        const uint64_t fromZero[] = { 0, 1, 2, 5, 63, 64 };
+        set.build(fromZero, 6);
+        CHECK(set.getKind() == MembershipSet::SET_BITMAP);
+        CHECK(matches_reference(set, std::vector<uint64_t>(fromZero, fromZero + 6)));
+    }
+
+    //! Up to SORTED_MAX sparse values are kept in the sorted vector, and more of them in the hash table
+    void test_sorted_boundary()
+    {
+        MembershipSet set;
+        const std::vector<uint64_t> few = sparse_values(3);
+        set.build(few);
+        CHECK(set.getKind() == MembershipSet::SET_SORTED);
+        CHECK(matches_reference(set, few));
+
+        const std::vector<uint64_t> atMax = sparse_values(MembershipSet::SORTED_MAX);
+        set.build(atMax);
+        CHECK(set.getKind() == MembershipSet::SET_SORTED);
+        CHECK(matches_reference(set, atMax));
+
+        const std::vector<uint64_t> overMax = sparse_values(MembershipSet::SORTED_MAX + 1);
+        set.build(overMax);
+        CHECK(set.getKind() == MembershipSet::SET_HASHED);
+        CHECK(matches_reference(set, overMax));
+    }
+
+    //! The zero marks the empty slots of the hash table, so it is stored aside
+    void test_hashed_zero()
+    {
+        std::vector<uint64_t> values = sparse_values(1000);
+        values.push_back(0);
+        values.push_back((uint64_t)(-1));
+        MembershipSet set;
+        set.build(values);
+        CHECK(set.getKind() == MembershipSet::SET_HASHED);
+        CHECK(set.contains(0));
+        CHECK(matches_reference(set, values));
+
+        // without the zero:
+        values.erase(values.end() - 2);
+        set.build(values);
+        CHECK(set.getKind() == MembershipSet::SET_HASHED);
+        CHECK(!set.contains(0));
+        CHECK(matches_reference(set, values));
+    }
+
+    //! The list parameter freezes its numbers when it is parsed
+    void test_int_list()
+    {
+        IntListParam param("list", false, ",");
+        CHECK(param.parse("1-100"));
+        CHECK(param.getMembershipSet().getKind() == util::MembershipSet::SET_BITMAP);
+        CHECK(param.contains(1) && param.contains(100) && !param.contains(0) && !param.contains(101));
+
+        CHECK(param.parse("0,0x100000000,7"));
+        CHECK(param.getMembershipSet().getKind() == util::MembershipSet::SET_SORTED);
+        CHECK(param.contains(0) && param.contains(0x100000000) && !param.contains(1));
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_empty();
+    test_bitmap();
+    test_sorted_boundary();
+    test_hashed_zero();
+    test_int_list();
+    return paramkit_test::summary("test_membership_set");
+}
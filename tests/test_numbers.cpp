@@ -0,0 +1,98 @@
+#include <paramkit.h>
+
+#include <string>
+#include <stdint.h>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    void test_load_number()
+    {
+        uint64_t out = 7;
+        CHECK(load_number("0", out) && out == 0);
+        CHECK(load_number("18446744073709551615", out) && out == UINT64_MAX);
+        CHECK(load_number("0xFFFFffffFFFFffff", out) && out == UINT64_MAX);
+        CHECK(load_number("0X1f", out) && out == 0x1f);
+        CHECK(load_number("ff", out, NUM_BASE_HEX) && out == 0xff);
+        CHECK(load_number(L"1234", out) && out == 1234);
+
+        // the given length is respected, even if the string is not terminated there:
+        CHECK(load_number("12345", 3, out) && out == 123);
+
+        out = 7;
+        CHECK(!load_number("18446744073709551616", out));
+        CHECK(!load_number("0x10000000000000000", out));
+        CHECK(!load_number("ff", out, NUM_BASE_DEC));
+        CHECK(!load_number("0x10", out, NUM_BASE_DEC));
+        CHECK(!load_number("0x", out));
+        CHECK(!load_number("", out));
+        CHECK(!load_number("-1", out));
+        CHECK(!load_number(" 1", out));
+        CHECK(!load_number("1 ", out));
+        CHECK(!load_number((const char*)nullptr, out));
+        CHECK(out == 7);
+    }
+
+    //! The wide strings are parsed by the same function as the narrow ones
+    void test_load_number_wide()
+    {
+        uint64_t out = 0;
+        CHECK(load_number(L"0x7ffe12345678", out) && out == 0x7ffe12345678ULL);
+        CHECK(load_number(L"18446744073709551615", out) && out == UINT64_MAX);
+        CHECK(!load_number(L"18446744073709551616", out));
+        // the non-ASCII characters are not truncated into the digits:
+        CHECK(!load_number(L"1\u0131", out));
+        CHECK(!load_number(L"\u0130", out));
+        // the long strings of the leading zeros don't fit in the local buffer:
+        const std::wstring zeros = L"0x" + std::wstring(300, L'0') + L"1f";
+        CHECK(load_number(zeros.c_str(), out) && out == 0x1f);
+    }
+
+    //! The legacy functions don't truncate the values that don't fit in their return types
+    void test_legacy_getters()
+    {
+        CHECK(get_number("0x10") == 0x10);
+        CHECK(get_number("2147483647") == 2147483647L);
+        CHECK(get_number("x") == 0);
+        CHECK(get_number("18446744073709551615") == 0);
+        CHECK(loadInt("123") == 123);
+        CHECK(loadInt("ff", true) == 0xff);
+        CHECK(loadInt("4294967297") == 0);
+    }
+
+    void test_int_param()
+    {
+        IntParam any("any", false);
+        CHECK(!any.isSet());
+        CHECK(any.parse("0x10") && any.value == 0x10);
+        CHECK(any.parse(L"42") && any.value == 42);
+        CHECK(!any.parse("4x2"));
+        CHECK(any.value == 42);
+        // the reserved value marks the parameter that is not set:
+        CHECK(!any.parse("0xffffffffffffffff"));
+        CHECK(any.isValidNumber("0xfffffffffffffffe", 18));
+        CHECK(!any.isValidNumber("0xffffffffffffffff", 18));
+        CHECK(any.isSet());
+
+        IntParam hex("hex", false, IntParam::INT_BASE_HEX);
+        CHECK(hex.parse("ff") && hex.value == 0xff);
+        CHECK(hex.valToString() == "ff");
+
+        IntParam dec("dec", false, IntParam::INT_BASE_DEC);
+        CHECK(!dec.parse("ff"));
+        CHECK(dec.parse("0255") && dec.value == 255);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_load_number();
+    test_load_number_wide();
+    test_legacy_getters();
+    test_int_param();
+    return paramkit_test::summary("test_numbers");
+}
@@ -0,0 +1,103 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <new>
+#include <cstdlib>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    size_t g_allocations = 0;
+
+}; // anonymous namespace
+
+// count all the allocations made by the program:
+void* operator new(size_t size)
+{
+    g_allocations++;
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+namespace {
+
+    //! Counts the allocations made while parsing the given arguments
+    template <typename T_CHAR>
+    size_t count_parse_allocations(Params &params, std::vector<T_CHAR*> &argv, bool &isParsed)
+    {
+        const size_t initial = g_allocations;
+        isParsed = params.parse((int)argv.size(), &argv[0]);
+        return g_allocations - initial;
+    }
+
+    //! The numeric, boolean and enum parameters are parsed directly from the arguments: without copying them
+    void test_no_allocations()
+    {
+        Params params;
+        params.addParam(new IntParam("num", true));
+        params.addParam(new IntParam("hex", false, IntParam::INT_BASE_HEX));
+        params.addParam(new BoolParam("flag", false));
+        EnumParam *mode = new EnumParam("mode", "t_mode", false);
+        mode->addEnumValue(0, "fast", "The fast mode");
+        mode->addEnumValue(1, "slow", "The slow mode");
+        params.addParam(mode);
+
+        char a0[] = "prog", a1[] = "/num", a2[] = "0x7ffe12345678", a3[] = "-hex", a4[] = "ff", a5[] = "--flag", a6[] = "/mode", a7[] = "slow";
+        std::vector<char*> argv;
+        char *args[] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+        argv.assign(args, args + 8);
+        bool isParsed = false;
+        const size_t allocations = count_parse_allocations(params, argv, isParsed);
+        CHECK(isParsed);
+        CHECK(allocations == 0);
+        CHECK(mode->value == 1);
+
+        wchar_t w0[] = L"prog", w1[] = L"/num", w2[] = L"12", w3[] = L"/flag", w4[] = L"false", w5[] = L"/mode", w6[] = L"fast";
+        std::vector<wchar_t*> wargv;
+        wchar_t *wargs[] = { w0, w1, w2, w3, w4, w5, w6 };
+        wargv.assign(wargs, wargs + 7);
+        const size_t wideAllocations = count_parse_allocations(params, wargv, isParsed);
+        CHECK(isParsed);
+        CHECK(wideAllocations == 0);
+        CHECK(mode->value == 0);
+    }
+
+    //! The string parameters allocate only to store their values
+    void test_string_allocations()
+    {
+        Params params;
+        StringParam *name = new StringParam("name", false);
+        params.addParam(name);
+
+        char a0[] = "prog", a1[] = "/name", a2[] = "a value that doesn't fit in the small string buffer";
+        char *args[] = { a0, a1, a2 };
+        std::vector<char*> argv(args, args + 3);
+        bool isParsed = false;
+        CHECK(count_parse_allocations(params, argv, isParsed) == 1);
+        CHECK(isParsed);
+        CHECK(name->value == a2);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_no_allocations();
+    test_string_allocations();
+    return paramkit_test::summary("test_parse_allocations");
+}
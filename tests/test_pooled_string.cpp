@@ -0,0 +1,124 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    //! The copies share the content, which is freed along with the last reference
+    void test_refcount()
+    {
+        const size_t initialCount = util::shared_texts_count();
+        {
+            util::PooledString first(std::string("pooled test string"));
+            CHECK(util::shared_texts_count() == initialCount + 1);
+            CHECK(first.isShared());
+
+            util::PooledString copy = first;
+            CHECK(copy.c_str() == first.c_str());
+            CHECK(util::shared_texts_count() == initialCount + 1);
+
+            // the equal string that was not interned is a separate copy:
+            util::PooledString second("pooled test string");
+            CHECK(second.c_str() != first.c_str());
+            CHECK(second == first);
+            CHECK(util::shared_texts_count() == initialCount + 2);
+
+            first.clear();
+            CHECK(first.empty());
+            second = util::PooledString::fromStatic("static");
+            CHECK(!second.isShared());
+            CHECK(util::shared_texts_count() == initialCount + 1);
+            CHECK(copy.str() == "pooled test string");
+
+            const util::PooledString &same = copy;
+            copy = same;
+            CHECK(copy.str() == "pooled test string");
+        }
+        CHECK(util::shared_texts_count() == initialCount);
+    }
+
+    //! The equal strings interned in the pool share a single copy
+    void test_pool()
+    {
+        const size_t initialCount = util::shared_texts_count();
+        {
+            util::StringPool pool;
+            util::PooledString first("repeated");
+            util::PooledString second(std::string("repeated"));
+            util::PooledString other("other");
+            util::PooledString literal = util::PooledString::fromStatic("repeated");
+            pool.intern(first);
+            pool.intern(second);
+            pool.intern(other);
+            pool.intern(literal);
+
+            CHECK(pool.size() == 2);
+            CHECK(first.c_str() == second.c_str());
+            CHECK(!literal.isShared());
+            CHECK(util::shared_texts_count() == initialCount + 2);
+
+            // the interned strings outlive the pool:
+            pool.clear();
+            CHECK(first.str() == "repeated");
+            CHECK(util::shared_texts_count() == initialCount + 2);
+        }
+        CHECK(util::shared_texts_count() == initialCount);
+    }
+
+    //! The copies are made without a lock, so they can be made by multiple threads at once
+    void test_concurrent_copies()
+    {
+        const size_t initialCount = util::shared_texts_count();
+        {
+            const util::PooledString shared("shared by the threads");
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < 4; t++) {
+                threads.push_back(std::thread([&shared]() {
+                    for (size_t i = 0; i < 10000; i++) {
+                        util::PooledString copy = shared;
+                        util::PooledString another;
+                        another = copy;
+                    }
+                }));
+            }
+            for (size_t t = 0; t < threads.size(); t++) {
+                threads[t].join();
+            }
+            CHECK(shared.str() == "shared by the threads");
+            CHECK(util::shared_texts_count() == initialCount + 1);
+        }
+        CHECK(util::shared_texts_count() == initialCount);
+    }
+
+    //! The descriptions of the parameters are interned in their container, and released along with the parameters
+    void test_params_release()
+    {
+        const size_t initialCount = util::shared_texts_count();
+        {
+            Params params;
+            for (size_t i = 0; i < 100; i++) {
+                IntParam *param = params.emplaceParam<IntParam>("param" + std::to_string(i), false);
+                param->setInfo("The description number " + std::to_string(i), "The extended description");
+            }
+            // the repeated extended description is stored once:
+            CHECK(util::shared_texts_count() == initialCount + 101);
+        }
+        CHECK(util::shared_texts_count() == initialCount);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_refcount();
+    test_pool();
+    test_concurrent_copies();
+    test_params_release();
+    return paramkit_test::summary("test_pooled_string");
+}
@@ -0,0 +1,117 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    bool contains(const std::string &text, const std::string &part)
+    {
+        return text.find(part) != std::string::npos;
+    }
+
+    //! Exposes the groups of the parameters
+    class GroupedParams : public Params {
+    public:
+        GroupedParams()
+        {
+            addParam(new IntParam("count", true));
+            addParam(new StringParam("path", false));
+            setInfo("count", "The number of the items");
+            setInfo("path", "The output path");
+            addGroup(new ParamGroup("Output"));
+        }
+    };
+
+    //! The cached rendering is updated after each change of the parameters
+    void test_invalidation()
+    {
+        GroupedParams params;
+        const std::string initial = params.infoToString();
+        CHECK(contains(initial, "The number of the items"));
+        CHECK(!contains(initial, "---Output---"));
+        // the same output is returned from the cache:
+        CHECK(params.infoToString() == initial);
+
+        // setInfo:
+        params.setInfo("count", "The count of the elements");
+        const std::string afterInfo = params.infoToString();
+        CHECK(contains(afterInfo, "The count of the elements"));
+        CHECK(!contains(afterInfo, "The number of the items"));
+
+        // both the extended and the brief output are updated:
+        CHECK(!contains(params.infoToString(false, "", false), "The unique output location"));
+        params.setInfo("path", "The unique output location");
+        CHECK(contains(params.infoToString(), "The unique output location"));
+        CHECK(contains(params.infoToString(false, "", false), "The unique output location"));
+
+        // addParam:
+        params.addParam(new BoolParam("verbose", false));
+        CHECK(contains(params.infoToString(), "/verbose"));
+        CHECK(contains(params.infoToString(false, "", false), "/verbose"));
+
+        // addParamToGroup:
+        CHECK(params.addParamToGroup("path", "Output"));
+        const std::string afterGroup = params.infoToString();
+        CHECK(contains(afterGroup, "---Output---"));
+        CHECK(afterGroup.find("---Output---") < afterGroup.find("/path"));
+    }
+
+    //! Returns the color in which the given part of the text is rendered, or -1 if it is not found
+    int color_of(const ColoredText &text, const std::string &part)
+    {
+        const size_t offset = text.str().find(part);
+        if (offset == std::string::npos) return (-1);
+
+        const std::vector<ColoredText::ColorSpan> &spans = text.colorSpans();
+        for (size_t i = 0; i < spans.size(); i++) {
+            if (offset >= spans[i].offset && offset < spans[i].offset + spans[i].length) {
+                return spans[i].color;
+            }
+        }
+        return (-1);
+    }
+
+    //! The inactive parameters are rendered in their own color, also in the cached output
+    void test_set_active()
+    {
+        Params params;
+        BoolParam *verbose = new BoolParam("verbose", false);
+        params.addParam(verbose);
+        params.addParam(new BoolParam("quiet", false));
+        CHECK(color_of(params.renderInfo(), "/verbose") == HILIGHTED_COLOR);
+
+        verbose->setActive(false);
+        CHECK(color_of(params.renderInfo(), "/verbose") == INACTIVE_COLOR);
+        CHECK(color_of(params.renderInfo(), "/quiet") == HILIGHTED_COLOR);
+
+        verbose->setActive(true);
+        CHECK(color_of(params.renderInfo(), "/verbose") == HILIGHTED_COLOR);
+    }
+
+    //! The values don't change the cached output, but they change the output hilighting the missing parameters
+    void test_values()
+    {
+        Params params;
+        IntParam *count = new IntParam("count", true);
+        params.addParam(count);
+        const std::string initial = params.infoToString();
+        CHECK(contains(params.infoToString(true), "/count"));
+
+        count->parse("5");
+        CHECK(params.infoToString() == initial);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_invalidation();
+    test_set_active();
+    test_values();
+    return paramkit_test::summary("test_render_info");
+}
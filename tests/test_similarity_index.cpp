@@ -0,0 +1,160 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <stdlib.h>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    std::string random_word(size_t minLen, size_t maxLen)
+    {
+        const char alphabet[] = "abcdeXY_1";
+        const size_t len = minLen + (size_t)(rand() % (maxLen - minLen + 1));
+        std::string word;
+        for (size_t i = 0; i < len; i++) {
+            word += alphabet[rand() % (sizeof(alphabet) - 1)];
+        }
+        return word;
+    }
+
+    //! The index must find exactly the names for which is_string_similar is true
+    void test_names_match_linear_scan()
+    {
+        srand(7);
+        util::SimilarityIndex index;
+        std::vector<std::string> names;
+        for (size_t i = 0; i < 300; i++) {
+            const std::string name = random_word(1, 14);
+            if (index.insert(name)) {
+                names.push_back(name);
+            }
+        }
+        for (size_t q = 0; q < 300; q++) {
+            const std::string filter = random_word(1, 16);
+            std::set<std::string> expected;
+            for (size_t i = 0; i < names.size(); i++) {
+                if (util::is_string_similar(names[i], filter) != util::SIM_NONE) {
+                    expected.insert(names[i]);
+                }
+            }
+            std::vector<util::SimilarName> found;
+            index.find(filter, found);
+            std::set<std::string> foundNames;
+            for (size_t i = 0; i < found.size(); i++) {
+                foundNames.insert(found[i].name);
+                CHECK(found[i].distance == util::levenshtein_distance(found[i].name.c_str(), filter.c_str()));
+            }
+            if (foundNames != expected) {
+                std::cerr << "filter: " << filter << ", found: " << foundNames.size() << ", expected: " << expected.size() << "\n";
+            }
+            CHECK(foundNames == expected);
+        }
+    }
+
+    //! Checks if each word of the keyword occurs (case insensitive) inside any of the words of the text
+    bool has_keyword_linear(const std::string &text, const std::string &keyword)
+    {
+        std::vector<std::string> keywordWords;
+        if (!util::KeywordIndex::splitWords(keyword, keywordWords)) return false;
+        const std::string lowText = util::to_lowercase(text);
+        for (size_t i = 0; i < keywordWords.size(); i++) {
+            // the keyword words don't contain the separators, so they can't span multiple words of the text:
+            if (lowText.find(keywordWords[i]) == std::string::npos) return false;
+        }
+        return true;
+    }
+
+    //! The index of many texts must find the same texts as the linear scan
+    void test_texts_match_linear_scan()
+    {
+        srand(11);
+        std::vector<std::string> texts(50);
+        util::KeywordIndex index;
+        for (size_t id = 0; id < texts.size(); id++) {
+            for (size_t w = 0; w < 6; w++) {
+                texts[id] += random_word(1, 8) + ((w % 2) ? " " : ", ");
+            }
+            // a text may be added in parts (split between the words):
+            const size_t half = texts[id].find(' ');
+            index.addText(texts[id].c_str(), half, id);
+            index.addText(texts[id].c_str() + half, texts[id].length() - half, id);
+        }
+        std::set<size_t> found;
+        CHECK(index.findTexts("a", found) == 0); // not built yet
+        index.build();
+        for (size_t q = 0; q < 200; q++) {
+            std::string keyword = random_word(1, 4);
+            if (q % 3 == 0) {
+                keyword += " " + random_word(1, 3);
+            }
+            std::set<size_t> expected;
+            for (size_t id = 0; id < texts.size(); id++) {
+                if (has_keyword_linear(texts[id], keyword)) {
+                    expected.insert(id);
+                }
+            }
+            found.clear();
+            CHECK(index.findTexts(keyword, found) == expected.size());
+            CHECK(found == expected);
+        }
+    }
+
+    //! Without the words, the texts are not found, but the ids of the following texts are still resolved
+    void test_texts_without_words()
+    {
+        util::KeywordIndex index;
+        index.addText("", 0);
+        index.addText(" -- ", 1);
+        index.addText("Alpha beta", 2);
+        index.addText("", 3);
+        index.addText("BETA_gamma", 4);
+        index.build();
+        std::set<size_t> found;
+        CHECK(index.findTexts("beta", found) == 2);
+        CHECK(found.count(2) && found.count(4));
+        found.clear();
+        CHECK(index.findTexts("a_g", found) == 1 && found.count(4));
+        CHECK(index.findTexts("", found) == 0);
+    }
+
+    bool is_listed(Params &params, const std::string &filter, const std::string &name)
+    {
+        return params.infoToString(false, filter).find(name) != std::string::npos;
+    }
+
+    //! The filtered help finds the parameters by the words of their descriptions, also after they were changed
+    void test_params_descriptions()
+    {
+        Params params;
+        IntParam *first = new IntParam("first", false);
+        StringParam *second = new StringParam("second", false);
+        params.addParam(first);
+        params.addParam(second);
+        first->setInfo("The number of the workers");
+        second->setInfo("Output path");
+
+        CHECK(is_listed(params, "workers", "first"));
+        CHECK(!is_listed(params, "workers", "second"));
+        CHECK(is_listed(params, "output path", "second"));
+        CHECK(!is_listed(params, "path number", "first"));
+
+        second->setInfo("The number of the files");
+        CHECK(is_listed(params, "number", "second"));
+        CHECK(!is_listed(params, "output", "second"));
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_names_match_linear_scan();
+    test_texts_match_linear_scan();
+    test_texts_without_words();
+    test_params_descriptions();
+    return paramkit_test::summary("test_similarity_index");
+}
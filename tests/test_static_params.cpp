@@ -0,0 +1,114 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    constexpr StaticParam g_schema[] = {
+        { "num", SPARAM_INT, true, "A required number", IntParam::INT_BASE_ANY },
+        { "hex", SPARAM_INT, false, "A hexadecimal number", IntParam::INT_BASE_HEX },
+        { "flag", SPARAM_BOOL, false, "A switch", IntParam::INT_BASE_ANY },
+        { "name", SPARAM_STRING, false, "A string", IntParam::INT_BASE_ANY }
+    };
+
+    constexpr StaticParam g_duplicates[] = {
+        { "a", SPARAM_INT, false, "", IntParam::INT_BASE_ANY },
+        { "b", SPARAM_INT, false, "", IntParam::INT_BASE_ANY },
+        { "a", SPARAM_BOOL, false, "", IntParam::INT_BASE_ANY }
+    };
+
+    // the names that differ only by the length, or by the last character:
+    constexpr StaticParam g_similar[] = {
+        { "ab", SPARAM_INT, false, "", IntParam::INT_BASE_ANY },
+        { "abc", SPARAM_INT, false, "", IntParam::INT_BASE_ANY },
+        { "abd", SPARAM_INT, false, "", IntParam::INT_BASE_ANY },
+        { "a", SPARAM_INT, false, "", IntParam::INT_BASE_ANY }
+    };
+
+#define SP_ENTRY(name) { name, SPARAM_INT, false, "", IntParam::INT_BASE_ANY },
+#define SP_10(p) SP_ENTRY(p "0") SP_ENTRY(p "1") SP_ENTRY(p "2") SP_ENTRY(p "3") SP_ENTRY(p "4") SP_ENTRY(p "5") SP_ENTRY(p "6") SP_ENTRY(p "7") SP_ENTRY(p "8") SP_ENTRY(p "9")
+#define SP_100(p) SP_10(p "0") SP_10(p "1") SP_10(p "2") SP_10(p "3") SP_10(p "4") SP_10(p "5") SP_10(p "6") SP_10(p "7") SP_10(p "8") SP_10(p "9")
+#define SP_1000(p) SP_100(p "0") SP_100(p "1") SP_100(p "2") SP_100(p "3") SP_100(p "4") SP_100(p "5") SP_100(p "6") SP_100(p "7") SP_100(p "8") SP_100(p "9")
+
+    PARAMKIT_CHECK_SCHEMA(g_schema);
+    PARAMKIT_CHECK_SCHEMA(g_similar);
+    static_assert(!are_names_unique(g_duplicates), "The duplicate names are not detected");
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304
+    // the big schemas are checked at compile time as well:
+    constexpr StaticParam g_big[] = { SP_1000("p") };
+    constexpr StaticParam g_bigDuplicate[] = { SP_1000("p") SP_ENTRY("p500") };
+
+    PARAMKIT_CHECK_SCHEMA(g_big);
+    static_assert(!are_names_unique(g_bigDuplicate), "The duplicate names are not detected in the big schema");
+#endif
+
+    typedef PARAMKIT_STATIC_PARAMS(g_schema) TestParams;
+
+    bool parse(TestParams &params, const std::vector<std::string> &args)
+    {
+        std::vector<std::string> storage(args);
+        std::vector<char*> argv;
+        for (size_t i = 0; i < storage.size(); i++) {
+            argv.push_back(&storage[i][0]);
+        }
+        params.clear();
+        return params.parse((int)argv.size(), &argv[0]);
+    }
+
+    void test_parse()
+    {
+        TestParams params;
+        const size_t numId = params.findParam("num");
+        const size_t hexId = params.findParam("hex");
+        const size_t flagId = params.findParam("flag");
+        const size_t nameId = params.findParam("name");
+        CHECK(numId == 0 && hexId == 1 && flagId == 2 && nameId == 3);
+        CHECK(params.findParam("nu") == 4);
+        CHECK(params.findParam("numb") == 4);
+
+        const char *args[] = { "prog", "/num", "0x10", "-hex", "ff", "--flag", "/name", "abc" };
+        std::vector<std::string> argv(args, args + 8);
+        CHECK(parse(params, argv));
+        CHECK(params.getInt(numId) == 0x10);
+        CHECK(params.getInt(hexId) == 0xff);
+        CHECK(params.getInt(flagId) == 1);
+        CHECK(params.getString(nameId) != nullptr);
+
+        // the boolean switch may be followed by the value:
+        const char *boolArgs[] = { "prog", "/flag", "false", "/num", "1" };
+        CHECK(parse(params, std::vector<std::string>(boolArgs, boolArgs + 5)));
+        CHECK(params.isSet(flagId) && params.getInt(flagId) == 0);
+
+        const char *invalid[] = { "prog", "/num", "x" };
+        CHECK(!parse(params, std::vector<std::string>(invalid, invalid + 3)));
+        const char *unknown[] = { "prog", "/num", "1", "/unknown" };
+        CHECK(!parse(params, std::vector<std::string>(unknown, unknown + 4)));
+    }
+
+    void test_required()
+    {
+        TestParams params;
+        const char *args[] = { "prog", "/hex", "1" };
+        CHECK(!parse(params, std::vector<std::string>(args, args + 3)));
+        CHECK(!params.hasRequiredFilled());
+        CHECK(params.getInt(params.findParam("num"), 7) == 7);
+
+        const char *withRequired[] = { "prog", "/num", "5" };
+        CHECK(parse(params, std::vector<std::string>(withRequired, withRequired + 3)));
+        CHECK(params.hasRequiredFilled());
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_parse();
+    test_required();
+    return paramkit_test::summary("test_static_params");
+}
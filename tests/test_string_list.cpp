@@ -0,0 +1,88 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    std::vector<std::string> elements_of(StringListParam &param)
+    {
+        std::vector<std::string> out;
+        util::Span<util::StringView> views = param.getElements();
+        for (util::Span<util::StringView>::const_iterator itr = views.begin(); itr != views.end(); ++itr) {
+            out.push_back(itr->str());
+        }
+        return out;
+    }
+
+    //! The elements are trimmed, the empty ones skipped, and the rest kept in the given order
+    void test_order()
+    {
+        StringListParam list("list", false, ',');
+        CHECK(list.parse(" c , a,,b ,a , "));
+        const std::vector<std::string> elements = elements_of(list);
+        CHECK(elements.size() == 4 && elements[0] == "c" && elements[1] == "a" && elements[2] == "b" && elements[3] == "a");
+
+        // the multi-character delimiter:
+        StringListParam multi("multi", false, std::string("::"));
+        CHECK(multi.parse("x::y:z::"));
+        const std::vector<std::string> multiElements = elements_of(multi);
+        CHECK(multiElements.size() == 2 && multiElements[0] == "x" && multiElements[1] == "y:z");
+    }
+
+    //! Optionally, the duplicates are removed, keeping the first occurrence of each element
+    void test_unique()
+    {
+        StringListParam list("list", false, ',');
+        CHECK(list.parse("c,a,b,a,c,d"));
+        CHECK(elements_of(list).size() == 6);
+
+        list.setUniqueElements(true);
+        const std::vector<std::string> elements = elements_of(list);
+        CHECK(elements.size() == 4 && elements[0] == "c" && elements[1] == "a" && elements[2] == "b" && elements[3] == "d");
+
+        std::set<std::string> sorted;
+        CHECK(list.stripToElements(sorted) == 4);
+        CHECK(*sorted.begin() == "a");
+
+        list.setUniqueElements(false);
+        CHECK(elements_of(list).size() == 6);
+    }
+
+    //! The cached elements are split again after any change of the value
+    void test_invalidation()
+    {
+        StringListParam list("list", false, ',');
+        CHECK(list.parse("aa,bb"));
+        CHECK(elements_of(list)[1] == "bb");
+
+        // parsed again, with the same length:
+        CHECK(list.parse("cc,dd"));
+        CHECK(elements_of(list)[1] == "dd");
+
+        // assigned directly, in the same buffer:
+        list.value[3] = 'x';
+        CHECK(elements_of(list)[1] == "xd");
+
+        // assigned directly, with the same length:
+        list.value = "ee,ff";
+        CHECK(elements_of(list)[0] == "ee");
+
+        list.value = "gg";
+        CHECK(elements_of(list).size() == 1);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_order();
+    test_unique();
+    test_invalidation();
+    return paramkit_test::summary("test_string_list");
+}
@@ -0,0 +1,103 @@
+#include <paramkit.h>
+
+#include <string>
+#include <sstream>
+#include <iostream>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    //! Captures everything printed on std::cout during its lifetime
+    class CoutCapture {
+    public:
+        CoutCapture()
+            : prevBuf(std::cout.rdbuf(captured.rdbuf()))
+        {
+        }
+
+        ~CoutCapture()
+        {
+            std::cout.rdbuf(prevBuf);
+        }
+
+        std::string str() const
+        {
+            return captured.str();
+        }
+
+    protected:
+        std::ostringstream captured;
+        std::streambuf *prevBuf;
+    };
+
+    ColoredText sample_text()
+    {
+        ColoredText text;
+        text.append("plain ");
+        text.append(RED, "red");
+        text.append(" and ");
+        text.append(MAKE_COLOR(WHITE, DARK_RED), "inverted");
+        return text;
+    }
+
+    //! Prints the sample text in the given mode, and returns the output
+    std::string print_in_mode(t_term_mode mode)
+    {
+        TermSink &sink = TermSink::stdoutSink();
+        const t_term_mode prevMode = sink.getMode();
+        sink.setMode(mode);
+
+        CoutCapture capture;
+        sink.print(sample_text());
+        sink.print(YELLOW, "!");
+        std::cout.flush();
+
+        sink.setMode(prevMode);
+        return capture.str();
+    }
+
+    //! The forced ANSI mode embeds the escape sequences around each colored span
+    void test_ansi()
+    {
+        const std::string out = print_in_mode(TERM_ANSI);
+        CHECK(out == "plain \x1b[91mred\x1b[0m and \x1b[97;41minverted\x1b[0m\x1b[93m!\x1b[0m");
+    }
+
+    //! Without the colors, the text is printed as it is
+    void test_no_colors()
+    {
+        const std::string out = print_in_mode(TERM_NO_COLORS);
+        CHECK(out == "plain red and inverted!");
+    }
+
+    //! The text without the colored spans is printed as it is, also in the ANSI mode
+    void test_ansi_without_spans()
+    {
+        TermSink &sink = TermSink::stdoutSink();
+        const t_term_mode prevMode = sink.getMode();
+        sink.setMode(TERM_ANSI);
+        ColoredText text;
+        text.append("no colors here");
+        std::string out;
+        {
+            CoutCapture capture;
+            sink.print(text);
+            std::cout.flush();
+            out = capture.str();
+        }
+        sink.setMode(prevMode);
+        CHECK(out == "no colors here");
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_ansi();
+    test_no_colors();
+    test_ansi_without_spans();
+    return paramkit_test::summary("test_term_sink");
+}
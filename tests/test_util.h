@@ -0,0 +1,37 @@
+/**
+* @file
+* @brief   Minimal helpers of the tests: the checks are counted, and the failures are reported with their location
+*/
+
+#pragma once
+
+#include <iostream>
+
+namespace paramkit_test {
+
+    inline int& failures_count()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline void report_failure(const char *expr, const char *file, int line)
+    {
+        std::cerr << file << ":" << line << ": check failed: " << expr << "\n";
+        failures_count()++;
+    }
+
+    //! Prints the summary, and returns the exit code of the test
+    inline int summary(const char *testName)
+    {
+        if (failures_count()) {
+            std::cerr << testName << ": " << failures_count() << " check(s) failed\n";
+            return 1;
+        }
+        std::cout << testName << ": OK\n";
+        return 0;
+    }
+
+}; //namespace paramkit_test
+
+#define CHECK(expr) do { if (!(expr)) paramkit_test::report_failure(#expr, __FILE__, __LINE__); } while (0)
@@ -0,0 +1,128 @@
+#include <paramkit.h>
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+#include "test_util.h"
+
+using namespace paramkit;
+
+namespace {
+
+    //! Each item is processed exactly once, and the workers are reused by the next batches
+    void test_batches()
+    {
+        util::WorkStealingPool pool;
+        for (size_t round = 0; round < 50; round++) {
+            const size_t itemsCount = 1 + round * 37;
+            const size_t threadsCount = 1 + (round % 4);
+            std::vector< std::atomic<int> > visits(itemsCount);
+            for (size_t i = 0; i < itemsCount; i++) {
+                visits[i] = 0;
+            }
+            pool.run(itemsCount, [&visits](size_t item) {
+                visits[item]++;
+            }, threadsCount, 1 + (round % 3));
+
+            for (size_t i = 0; i < itemsCount; i++) {
+                CHECK(visits[i] == 1);
+            }
+            CHECK(pool.workersCount() <= 3);
+        }
+        CHECK(pool.workersCount() == 3);
+    }
+
+    //! The exception thrown by the task is passed to the caller, and the pool stays usable
+    void test_exception()
+    {
+        util::WorkStealingPool pool;
+        bool isCaught = false;
+        try {
+            pool.run(1000, [](size_t item) {
+                if (item == 500) throw std::runtime_error("failed item");
+            }, 4);
+        }
+        catch (const std::runtime_error &e) {
+            isCaught = (std::string(e.what()) == "failed item");
+        }
+        CHECK(isCaught);
+
+        std::atomic<size_t> processed(0);
+        pool.run(1000, [&processed](size_t) {
+            processed++;
+        }, 4);
+        CHECK(processed == 1000);
+    }
+
+    //! The batch of the command lines gives the same results as parsing them one by one
+    void test_parse_batch()
+    {
+        Params params;
+        params.addParam(new IntParam("num", true));
+        params.addParam(new StringParam("name", false));
+
+        std::vector<std::string> storage;
+        for (size_t i = 0; i < 200; i++) {
+            storage.push_back("/num");
+            storage.push_back(std::to_string(i));
+        }
+        std::vector< std::vector<char*> > argvs(100);
+        for (size_t i = 0; i < argvs.size(); i++) {
+            argvs[i].push_back(const_cast<char*>("prog"));
+            if (i % 10 == 0) continue; // the required parameter is missing
+            argvs[i].push_back(&storage[i * 2][0]);
+            argvs[i].push_back(&storage[i * 2 + 1][0]);
+        }
+        std::vector<ParsedValues> results;
+        for (size_t round = 0; round < 3; round++) {
+            CHECK(params.parseBatch(argvs, results, 4) == 90);
+        }
+        CHECK(results.size() == argvs.size());
+        const size_t numId = params.getParamId("num");
+        for (size_t i = 0; i < results.size(); i++) {
+            CHECK(results[i].isParsed() == (i % 10 != 0));
+            if (i % 10 == 0) continue;
+            CHECK(results[i].isSet(numId));
+        }
+    }
+
+    //! The pool of threads can be shared by multiple objects
+    void test_shared_pool()
+    {
+        util::WorkStealingPool pool;
+        Params first;
+        first.addParam(new IntParam("num", true));
+        Params second;
+        second.addParam(new BoolParam("flag", true));
+
+        std::vector< std::vector<char*> > argvs(50);
+        for (size_t i = 0; i < argvs.size(); i++) {
+            argvs[i].push_back(const_cast<char*>("prog"));
+            if (i % 2) {
+                argvs[i].push_back(const_cast<char*>("/num"));
+                argvs[i].push_back(const_cast<char*>("1"));
+                continue;
+            }
+            argvs[i].push_back(const_cast<char*>("/flag"));
+        }
+        // each command line is valid only for one of the objects:
+        std::vector<ParsedValues> results;
+        CHECK(first.parseBatch(argvs, results, pool, 4) == 25);
+        CHECK(results[1].isParsed() && !results[0].isParsed());
+        CHECK(second.parseBatch(argvs, results, pool, 4) == 25);
+        CHECK(results[0].isParsed() && !results[1].isParsed());
+        CHECK(pool.workersCount() > 0);
+    }
+
+}; // anonymous namespace
+
+int main()
+{
+    test_batches();
+    test_exception();
+    test_parse_batch();
+    test_shared_pool();
+    return paramkit_test::summary("test_work_pool");
+}